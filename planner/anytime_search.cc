@@ -0,0 +1,201 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+#include "anytime_search.h"
+#include "open_list.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+typedef unordered_map<const State*, const SearchNode*, StatePtrHash, StatePtrEqual> BestNodes;
+
+// weight at which the weighted cost is (cost + heuristic cost) / 2
+const float kFinalWeight = 0.5f;
+
+// prints the plan leading to node on one line, so that it is not mistaken for
+// the final plan printed by Search
+void PrintPlan(const SearchNode &node, int num_plans, float weight) {
+  vector<SearchNode::PathPair> path;
+  node.GetPath(&path);
+  cout << "plan " << num_plans << " at weight " << weight << ", cost " << node.GetCost() << ":";
+  // the last pair is the initial state with no action
+  for (int i = path.size() - 2; i >= 0; --i) {
+    cout << " " << path[i].action.GetPlanString();
+  }
+  cout << endl;
+}
+
+} // namespace
+
+bool AnytimeSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  if (options.anytime_step <= 0.f) {
+    cerr << "anytime step must be positive" << endl;
+    return false;
+  }
+
+  vector<unique_ptr<SearchNode>> visited;
+  unique_ptr<OpenList> agenda = CreateOpenList(options, goal_set, operators, env);
+  if (agenda == nullptr) {
+    cerr << "invalid open list " << options.open_list << endl;
+    return false;
+  }
+
+  // cheapest node generated so far for every state
+  BestNodes best_nodes;
+  // states expanded in the current round
+  StateSet expanded;
+  // nodes that got cheaper after their state was expanded in this round
+  vector<const SearchNode*> inconsistent;
+  // cheapest goal node found so far
+  const SearchNode *incumbent = nullptr;
+  // expanded node with the lowest heuristic cost, for an interrupted search
+  // that found no goal
+  const SearchNode *best_partial = nullptr;
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_prev_expanded = 0;
+  int count_duplicates = 0;
+  int num_plans = 0;
+  float weight = options.weight;
+
+  float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  visited.emplace_back(new SearchNode(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, weight));
+  best_nodes[visited.back()->GetState()] = visited.back().get();
+  agenda->push(visited.back().get());
+
+  while (true) {
+    while (!agenda->empty() && !options.Interrupted()) {
+      const SearchNode *node = agenda->pop();
+      const State *state = node->GetState();
+      if (best_nodes[state] != node || expanded.count(state) > 0) {
+        count_prev_expanded++;
+        continue;
+      }
+      if (incumbent != nullptr && node->GetWeightedCost() >= incumbent->GetWeightedCost()) {
+        // no queued node can lead to a cheaper goal at this weight
+        agenda->push(node);
+        break;
+      }
+      expanded.insert(state);
+      count_expanded++;
+      if (best_partial == nullptr || node->GetHeuristicCost() < best_partial->GetHeuristicCost()) {
+        best_partial = node;
+      }
+
+      if (SatisfiedGoal(goal_set, *state) != nullptr) {
+        if (incumbent == nullptr || node->GetParentActionCost() < incumbent->GetParentActionCost()) {
+          incumbent = node;
+          PrintPlan(*node, ++num_plans, weight);
+        }
+        continue;
+      }
+
+      vector<unique_ptr<Action>> actions;
+      node->Actions(operators, env, &actions);
+      // new states are evaluated together, known ones keep their heuristic cost
+      vector<unique_ptr<State>> new_states(actions.size());
+      vector<float> heuristic_costs(actions.size());
+      vector<const State*> eval_states;
+      vector<int> eval_indices;
+      for (int i = 0; i < actions.size(); ++i) {
+        unique_ptr<State> new_state = node->CreateSuccessor(*actions[i], false);
+        if (new_state->Hash() == state->Hash() && new_state->ApproximatelyEquals(state) && state->ApproximatelyEquals(new_state.get())) {
+          count_duplicates++;
+          continue;
+        }
+        BestNodes::const_iterator best = best_nodes.find(new_state.get());
+        if (best == best_nodes.end()) {
+          eval_states.push_back(new_state.get());
+          eval_indices.push_back(i);
+        } else if (node->GetParentActionCost() + actions[i]->GetCost() < best->second->GetParentActionCost()) {
+          heuristic_costs[i] = best->second->GetHeuristicCost();
+        } else {
+          count_duplicates++;
+          continue;
+        }
+        new_states[i] = move(new_state);
+      }
+      for (int i = 0; i < eval_indices.size(); ++i) {
+        heuristic_costs[eval_indices[i]] = h.MinCost(*eval_states[i], goal_set, operators, env);
+      }
+
+      for (int i = 0; i < actions.size(); ++i) {
+        if (new_states[i] == nullptr) {
+          continue;
+        }
+        // an earlier sibling may have queued the state since it was checked
+        BestNodes::iterator best = best_nodes.find(new_states[i].get());
+        if (best != best_nodes.end() && node->GetParentActionCost() + actions[i]->GetCost() >= best->second->GetParentActionCost()) {
+          count_duplicates++;
+          continue;
+        }
+        visited.emplace_back(new SearchNode(move(new_states[i]), node, move(actions[i]), heuristic_costs[i], ++count_visited, weight));
+        const SearchNode *child = visited.back().get();
+        if (best != best_nodes.end()) {
+          best_nodes.erase(best);
+        }
+        best_nodes[child->GetState()] = child;
+        if (expanded.count(child->GetState()) > 0) {
+          inconsistent.push_back(child);
+        } else {
+          agenda->push(child);
+        }
+      }
+    }
+
+    if (incumbent == nullptr) {
+      cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped" << endl;
+      if (best_partial != nullptr && options.Interrupted()) {
+        ReturnInterruptedPlan(*best_partial, count_expanded, "the expanded node with the lowest heuristic cost", best_partial->GetHeuristicCost(), options, path, costs);
+      }
+      return false;
+    }
+    cout << "round at weight " << weight << " done, " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, best cost: " << incumbent->GetCost() << endl;
+    if (weight >= kFinalWeight || (agenda->empty() && inconsistent.empty()) || options.Interrupted()) {
+      break;
+    }
+
+    // next round: re-key the open and inconsistent nodes by the new weight
+    weight = min(kFinalWeight, weight + options.anytime_step);
+    for (unique_ptr<SearchNode> &node : visited) {
+      node->SetWeight(weight);
+    }
+    vector<const SearchNode*> queued;
+    agenda->Release(&queued);
+    queued.insert(queued.end(), inconsistent.begin(), inconsistent.end());
+    inconsistent.clear();
+    expanded.clear();
+    for (const SearchNode *node : queued) {
+      if (best_nodes[node->GetState()] == node) {
+        agenda->push(node);
+      }
+    }
+  }
+
+  cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped, " << num_plans << " plans found, solution cost: " << incumbent->GetCost() << endl;
+  incumbent->GetPath(path);
+  incumbent->GetCosts(costs);
+  return true;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANYTIME_SEARCH_H
+#define ANYTIME_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Anytime repairing search (ARA*). Starts with options.weight and raises the
+// weight by options.anytime_step after each solution until it reaches 0.5,
+// where the weighted cost is proportional to cost so far plus heuristic cost.
+//
+// Every round expands each state at most once and stops as soon as no queued
+// node is cheaper than the best goal node found so far. Nodes that get
+// cheaper after their state was expanded in the current round are set aside
+// and queued again, together with the open nodes re-keyed by the new weight,
+// at the start of the next round. Nothing else is searched again.
+//
+// Each cheaper plan is printed on a single line as soon as it is found, and
+// the last one is returned in path and costs, also if the search is
+// interrupted (see SearchOptions::Interrupted) before the final round.
+//
+// this function will take ownership of initial_state
+bool AnytimeSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // ANYTIME_SEARCH_H
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+#include "beam_search.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+typedef vector<unique_ptr<SearchNode>> Layer;
+typedef unordered_map<const State*, int, StatePtrHash, StatePtrEqual> LayerIndex;
+
+// lowest heuristic cost first, then cheapest, then oldest
+bool BetterNode(const unique_ptr<SearchNode> &a, const unique_ptr<SearchNode> &b) {
+  if (a->GetHeuristicCost() != b->GetHeuristicCost()) {
+    return a->GetHeuristicCost() < b->GetHeuristicCost();
+  }
+  if (a->GetParentActionCost() != b->GetParentActionCost()) {
+    return a->GetParentActionCost() < b->GetParentActionCost();
+  }
+  return a->GetCount() < b->GetCount();
+}
+
+struct BeamResult {
+  BeamResult() : goal_node(nullptr), goal_state(nullptr), best_partial(nullptr), interrupted(false), count_visited(0), count_expanded(0), count_duplicates(0) {}
+
+  const SearchNode *goal_node;
+  const State *goal_state;
+  // node with the lowest heuristic cost, for an interrupted search
+  const SearchNode *best_partial;
+  bool interrupted;
+  int count_visited;
+  int count_expanded;
+  int count_duplicates;
+};
+
+// one beam search of the given width, the layers own the nodes of result
+void SearchBeam(const State &initial_state, float initial_heuristic_cost, int width, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, const SearchOptions &options, vector<Layer> *layers, BeamResult *result) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  layers->emplace_back();
+  layers->back().emplace_back(new SearchNode(unique_ptr<const State>(new State(initial_state)), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++result->count_visited, 0.f));
+  result->best_partial = layers->back().back().get();
+  // states of the nodes in the layers, which are kept anyway
+  StateSet kept;
+  kept.insert(result->best_partial->GetState());
+
+  while (!layers->back().empty() && layers->size() <= options.beam_depth) {
+    // goals are checked when the layer is reached, the cheapest is taken
+    for (const unique_ptr<SearchNode> &node : layers->back()) {
+      const State *goal_state = SatisfiedGoal(goal_set, *node->GetState());
+      if (goal_state != nullptr && (result->goal_node == nullptr || node->GetParentActionCost() < result->goal_node->GetParentActionCost())) {
+        result->goal_node = node.get();
+        result->goal_state = goal_state;
+      }
+    }
+    if (result->goal_node != nullptr) {
+      return;
+    }
+
+    Layer children;
+    LayerIndex index;
+    for (const unique_ptr<SearchNode> &node : layers->back()) {
+      if (options.Interrupted()) {
+        result->interrupted = true;
+        return;
+      }
+      result->count_expanded++;
+
+      vector<unique_ptr<Action>> actions;
+      node->Actions(operators, env, &actions);
+      vector<unique_ptr<State>> new_states;
+      vector<const State*> eval_states;
+      vector<int> indices;
+      for (int i = 0; i < actions.size(); ++i) {
+        unique_ptr<State> new_state = node->CreateSuccessor(*actions[i], false);
+        if (kept.count(new_state.get()) > 0) {
+          result->count_duplicates++;
+          continue;
+        }
+        eval_states.push_back(new_state.get());
+        new_states.push_back(move(new_state));
+        indices.push_back(i);
+      }
+      vector<float> heuristic_costs;
+      for (const State *eval_state : eval_states) {
+        heuristic_costs.push_back(h.MinCost(*eval_state, goal_set, operators, env));
+      }
+
+      for (int j = 0; j < new_states.size(); ++j) {
+        unique_ptr<SearchNode> child(new SearchNode(move(new_states[j]), node.get(), move(actions[indices[j]]), heuristic_costs[j], ++result->count_visited, 0.f));
+        LayerIndex::iterator sibling = index.find(child->GetState());
+        if (sibling == index.end()) {
+          index[child->GetState()] = children.size();
+          children.push_back(move(child));
+        } else {
+          result->count_duplicates++;
+          if (BetterNode(child, children[sibling->second])) {
+            // the index points at the state of the node it replaces
+            int i = sibling->second;
+            index.erase(sibling);
+            children[i] = move(child);
+            index[children[i]->GetState()] = i;
+          }
+        }
+      }
+    }
+
+    if (children.size() > width) {
+      nth_element(children.begin(), children.begin() + width, children.end(), BetterNode);
+      children.resize(width);
+    }
+    for (const unique_ptr<SearchNode> &child : children) {
+      kept.insert(child->GetState());
+      if (child->GetHeuristicCost() < result->best_partial->GetHeuristicCost()) {
+        result->best_partial = child.get();
+      }
+    }
+    layers->push_back(move(children));
+
+    if (!options.verbose && !options.quiet && (layers->size() % 10) == 0) {cout << "depth " << layers->size() - 1 << ", " << result->count_expanded << " nodes expanded, best heuristic cost: " << result->best_partial->GetHeuristicCost() << endl;}
+  }
+}
+
+} // namespace
+
+bool BeamSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  if (options.beam_width <= 0) {
+    cerr << "beam width must be positive" << endl;
+    return false;
+  }
+
+  float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  int width = options.beam_width;
+  for (int restart = 0; restart <= options.beam_restarts; ++restart, width *= 2) {
+    vector<Layer> layers;
+    BeamResult result;
+    SearchBeam(*initial_state, initial_heuristic_cost, width, goal_set, operators, h, env, options, &layers, &result);
+
+    if (result.goal_node != nullptr) {
+      cout << "found goal state! " << result.count_expanded << " nodes expanded, " << result.count_visited << " nodes visited, " << result.count_duplicates << " duplicates dropped, beam width " << width << ", depth " << layers.size() - 1 << ", solution cost: " << result.goal_node->GetCost() << endl;
+      cout << "satisfies goal state " << *result.goal_state << endl;
+      result.goal_node->GetPath(path);
+      result.goal_node->GetCosts(costs);
+      return true;
+    }
+    if (result.interrupted) {
+      ReturnInterruptedPlan(*result.best_partial, result.count_expanded, "the node with the lowest heuristic cost", result.best_partial->GetHeuristicCost(), options, path, costs);
+      return false;
+    }
+    cout << "beam search of width " << width << " failed at depth " << layers.size() - 1 << " after " << result.count_expanded << " nodes expanded" << endl;
+  }
+
+  // search failed
+  return false;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BEAM_SEARCH_H
+#define BEAM_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Beam search. Each layer keeps the options.beam_width children of the
+// previous layer with the lowest heuristic costs, so at most beam_width nodes
+// per depth are kept. Children with the state of a node in an earlier layer or
+// of a better sibling in the same layer are dropped.
+//
+// The search fails when a layer is empty or options.beam_depth layers were
+// searched without reaching a goal. It is then restarted with twice the beam
+// width, up to options.beam_restarts times.
+//
+// this function will take ownership of initial_state
+bool BeamSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // BEAM_SEARCH_H
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "dominance.h"
+
+using namespace std;
+
+DominanceTable::DominanceTable(const vector<const State*> &goal_set) {
+  for (const State *goal_state : goal_set) {
+    for (const Fluent &fluent : goal_state->GetFluents()) {
+      if (goal_fluent_set_.insert(fluent).second) {
+        goal_fluents_.push_back(fluent);
+      }
+    }
+  }
+}
+
+bool DominanceTable::Dominated(const State &state, float cost) const {
+  unordered_map<Key, vector<Entry>, KeyHash>::const_iterator bucket = entries_.find(GetKey(state));
+  if (bucket == entries_.end()) {
+    return false;
+  }
+  const vector<float> goal_probs = GetGoalProbs(state);
+  for (const Entry &entry : bucket->second) {
+    if (entry.cost <= cost && AtLeastAsProbable(entry.goal_probs, goal_probs)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DominanceTable::Add(const State &state, float cost) {
+  vector<Entry> &bucket = entries_[GetKey(state)];
+  Entry entry = {GetGoalProbs(state), cost};
+  bucket.erase(remove_if(bucket.begin(), bucket.end(), [&entry](const Entry &other) {
+    return entry.cost <= other.cost && AtLeastAsProbable(entry.goal_probs, other.goal_probs);
+  }), bucket.end());
+  bucket.push_back(move(entry));
+}
+
+size_t DominanceTable::KeyHash::operator()(const Key &key) const {
+  size_t seed = 0;
+  for (size_t hash : key) {
+    HashCombine(hash, &seed);
+  }
+  return seed;
+}
+
+DominanceTable::Key DominanceTable::GetKey(const State &state) const {
+  // fluent hashes cover the rounded probability
+  Key key;
+  for (const Fluent &fluent : state.GetFluents()) {
+    if (goal_fluent_set_.count(fluent) == 0 || fluent.RoundProb(fluent.GetProb()) >= fluent.RoundProb(1.f)) {
+      key.push_back(fluent.Hash());
+    }
+  }
+  sort(key.begin(), key.end());
+  return key;
+}
+
+vector<float> DominanceTable::GetGoalProbs(const State &state) const {
+  vector<float> goal_probs;
+  for (const Fluent &fluent : goal_fluents_) {
+    goal_probs.push_back(state.GetProb(fluent));
+  }
+  return goal_probs;
+}
+
+bool DominanceTable::AtLeastAsProbable(const vector<float> &a, const vector<float> &b) {
+  for (int i = 0; i < a.size(); ++i) {
+    if (a[i] < b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DOMINANCE_H
+#define DOMINANCE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "support.h"
+
+// Dominance between belief states reached by the search. A state dominates
+// another if they have the same certain part (the fluents with probability 1)
+// and the same fluents outside of the goals (compared like the state hash),
+// every goal fluent is at least as probable in it and it was reached at no
+// higher cost. States are indexed by that fixed part, so a check only looks at
+// the states that share it.
+class DominanceTable {
+ public:
+  DominanceTable(const std::vector<const State*> &goal_set);
+
+  // true if a state added before dominates state reached at cost
+  bool Dominated(const State &state, float cost) const;
+
+  // adds state reached at cost, forgetting the states it dominates
+  void Add(const State &state, float cost);
+
+ private:
+  typedef std::vector<size_t> Key;
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  struct Entry {
+    std::vector<float> goal_probs;
+    float cost;
+  };
+
+  Key GetKey(const State &state) const;
+
+  std::vector<float> GetGoalProbs(const State &state) const;
+
+  // true if a has every goal fluent at least as probable as b
+  static bool AtLeastAsProbable(const std::vector<float> &a, const std::vector<float> &b);
+
+  std::vector<Fluent> goal_fluents_;
+  FluentExcludingProbSet goal_fluent_set_;
+  std::unordered_map<Key, std::vector<Entry>, KeyHash> entries_;
+};
+
+#endif  // DOMINANCE_H
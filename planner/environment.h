@@ -17,9 +17,36 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 
+#include <vector>
+
+#include "support.h"
+
+// Objects of one type, numbered from 0, and where they appear in fluents: as
+// the argument at a position or, for position -1, as the value of a predicate.
+struct ObjectType {
+  struct Slot {
+    int predicate;
+    int position;
+  };
+
+  int num_objects;
+  std::vector<Slot> slots;
+};
+
 class Environment {
    public:
        virtual ~Environment() {}
+
+       // types of objects that may be interchangeable (see symmetry.h)
+       virtual void GetObjectTypes(std::vector<ObjectType> *types) const {}
+
+       // numbers that describe the layout (e.g. sizes and object locations),
+       // so that tables built for it are not used with another one
+       virtual void GetParameters(std::vector<int> *parameters) const {}
+
+       // fluents that no plan from start_state to the goal needs, whatever the
+       // probabilities (see relevance.h)
+       virtual void GetIrrelevantFluents(const State &start_state, const std::vector<const State*> &goal_set, std::vector<Fluent> *fluents) const {}
 };
 
 #endif  // ENVIRONMENT_H
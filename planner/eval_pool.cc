@@ -0,0 +1,92 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "eval_pool.h"
+
+using namespace std;
+
+EvaluationPool::EvaluationPool(int num_threads) : batch_(0), num_busy_(0), stop_(false), task_(nullptr), count_(0), next_(0) {
+  for (int i = 1; i < num_threads; ++i) {
+    threads_.emplace_back(&EvaluationPool::Run, this);
+  }
+}
+
+EvaluationPool::~EvaluationPool() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (thread &t : threads_) {
+    t.join();
+  }
+}
+
+void EvaluationPool::ForEach(int count, const function<void(int)> &task) {
+  if (count < 2 || threads_.empty()) {
+    for (int i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    lock_guard<mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_ = 0;
+    num_busy_ = threads_.size();
+    ++batch_;
+  }
+  start_.notify_all();
+  Work();
+
+  unique_lock<mutex> lock(mutex_);
+  finished_.wait(lock, [this] { return num_busy_ == 0; });
+}
+
+void EvaluationPool::MinCosts(const Heuristic &h, const vector<const State*> &states, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, vector<float> *costs) {
+  costs->resize(states.size());
+  ForEach(states.size(), [&](int i) {
+    (*costs)[i] = h.MinCost(*states[i], goal_set, operators, env);
+  });
+}
+
+void EvaluationPool::Run() {
+  int batch = 0;
+  while (true) {
+    {
+      unique_lock<mutex> lock(mutex_);
+      start_.wait(lock, [this, batch] { return stop_ || batch_ != batch; });
+      if (stop_) {
+        return;
+      }
+      batch = batch_;
+    }
+    Work();
+    {
+      lock_guard<mutex> lock(mutex_);
+      --num_busy_;
+    }
+    finished_.notify_one();
+  }
+}
+
+void EvaluationPool::Work() {
+  for (int i = next_++; i < count_; i = next_++) {
+    (*task_)(i);
+  }
+}
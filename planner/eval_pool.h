@@ -0,0 +1,68 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVAL_POOL_H
+#define EVAL_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "support.h"
+
+// Threads that evaluate the heuristic for a batch of states, such as the new
+// children of one expansion, or run other independent tasks of a search step.
+// The calling thread takes part in every batch and tasks are handed out one at
+// a time, so slow tasks do not hold up a fixed share of the batch.
+class EvaluationPool {
+ public:
+  // num_threads counts the calling thread, so num_threads - 1 are started
+  EvaluationPool(int num_threads);
+
+  ~EvaluationPool();
+
+  // runs task(0) ... task(count - 1), returns once all are done
+  void ForEach(int count, const std::function<void(int)> &task);
+
+  // (*costs)[i] = h.MinCost(*states[i], ...), returns once all are done
+  void MinCosts(const Heuristic &h, const std::vector<const State*> &states, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env, std::vector<float> *costs);
+
+ private:
+  void Run();
+
+  // runs tasks of the current batch until none is left
+  void Work();
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finished_;
+  int batch_; // number of the current batch, guarded by mutex_
+  int num_busy_; // threads still in the current batch, guarded by mutex_
+  bool stop_; // guarded by mutex_
+
+  // current batch, set while no thread is busy
+  const std::function<void(int)> *task_;
+  int count_;
+  std::atomic<int> next_; // next task to run
+};
+
+#endif  // EVAL_POOL_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+#include "greedy_search.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+// (heuristic cost, count, node), lowest cost and then oldest first
+typedef tuple<float, int, const SearchNode*> Entry;
+typedef priority_queue<Entry, vector<Entry>, greater<Entry>> Queue;
+
+const int kRegular = 0;
+const int kPreferred = 1;
+
+bool SameAction(const Action &a, const Action &b) {
+  return a.GetName() == b.GetName() && a.GetInfo() == b.GetInfo();
+}
+
+} // namespace
+
+bool GreedySearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  vector<unique_ptr<SearchNode>> visited;
+  // states that have been queued
+  StateSet seen;
+  StateSet expanded;
+  Queue queues[2];
+  // the queue with the lower priority is popped next
+  int priorities[2] = {0, 0};
+  float best_heuristic_cost = numeric_limits<float>::infinity();
+  const SearchNode *best_partial = nullptr;
+  float best_partial_cost = numeric_limits<float>::infinity();
+  // the relaxed plan that gives the helpful actions also gives the heuristic
+  // cost, so preferred children are evaluated when expanded as well
+  const bool deferred = options.deferred || options.preferred;
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_evaluated = 0;
+  int count_duplicates = 0;
+  int count_preferred = 0;
+
+  float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  count_evaluated++;
+  visited.emplace_back(new SearchNode(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, 0.f));
+  seen.insert(visited.back()->GetState());
+  queues[kRegular].push(Entry(initial_heuristic_cost, count_visited, visited.back().get()));
+
+  while (!queues[kRegular].empty() || !queues[kPreferred].empty()) {
+    if (options.Interrupted()) {
+      if (best_partial != nullptr) {
+        ReturnInterruptedPlan(*best_partial, count_expanded, "the expanded node with the lowest heuristic cost", best_partial_cost, options, path, costs);
+      }
+      return false;
+    }
+
+    int q = (queues[kPreferred].empty() || (!queues[kRegular].empty() && priorities[kRegular] <= priorities[kPreferred])) ? kRegular : kPreferred;
+    const SearchNode *node = get<2>(queues[q].top());
+    queues[q].pop();
+    priorities[q]++;
+    const State *state = node->GetState();
+
+    // preferred children are in both queues
+    if (expanded.count(state) > 0) {
+      continue;
+    }
+    expanded.insert(state);
+    count_expanded++;
+
+    const State *goal_state = SatisfiedGoal(goal_set, *state);
+    if (goal_state != nullptr) {
+      cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_evaluated << " heuristic evaluations, " << count_duplicates << " duplicates dropped, " << count_preferred << " preferred children, solution cost: " << node->GetCost() << endl;
+      cout << "satisfies goal state " << *goal_state << endl;
+      node->GetPath(path);
+      node->GetCosts(costs);
+      return true;
+    }
+
+    // a deferred node's stored cost is its parent's
+    float node_heuristic_cost = node->GetHeuristicCost();
+    vector<unique_ptr<Action>> helpful;
+    if (options.preferred) {
+      node_heuristic_cost = RelaxedPlanCost(*state, goal_set, operators, env, &helpful);
+      count_evaluated++;
+    } else if (options.deferred) {
+      node_heuristic_cost = HeuristicCost(h, *state, goal_set, operators, env);
+      count_evaluated++;
+    }
+    if (best_partial == nullptr || node_heuristic_cost < best_partial_cost) {
+      best_partial = node;
+      best_partial_cost = node_heuristic_cost;
+    }
+    if (deferred && node_heuristic_cost < best_heuristic_cost) {
+      best_heuristic_cost = node_heuristic_cost;
+      priorities[kPreferred] -= options.preferred_boost;
+    }
+
+    // deferred evaluation gives the children the cost of their parent
+    vector<unique_ptr<State>> new_states;
+    vector<unique_ptr<Action>> actions;
+    vector<float> heuristic_costs;
+    count_duplicates += UnseenChildren(*node, goal_set, operators, deferred ? nullptr : &h, env, &seen, &new_states, &actions, &heuristic_costs);
+    if (deferred) {
+      heuristic_costs.assign(new_states.size(), node_heuristic_cost);
+    } else {
+      count_evaluated += new_states.size();
+    }
+
+    for (int j = 0; j < new_states.size(); ++j) {
+      const Action &action = *actions[j];
+      bool preferred = false;
+      for (const unique_ptr<Action> &a : helpful) {
+        preferred = preferred || SameAction(*a, action);
+      }
+      visited.emplace_back(new SearchNode(move(new_states[j]), node, move(actions[j]), heuristic_costs[j], ++count_visited, 0.f));
+      const SearchNode *child = visited.back().get();
+      queues[kRegular].push(Entry(heuristic_costs[j], count_visited, child));
+      if (preferred) {
+        queues[kPreferred].push(Entry(heuristic_costs[j], count_visited, child));
+        count_preferred++;
+      }
+      if (!deferred && heuristic_costs[j] < best_heuristic_cost) {
+        best_heuristic_cost = heuristic_costs[j];
+        priorities[kPreferred] -= options.preferred_boost;
+      }
+    }
+
+    if (!options.verbose && !options.quiet && (count_expanded % 100) == 0) {cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_evaluated << " heuristic evaluations, best heuristic cost: " << best_heuristic_cost << endl;}
+  }
+
+  // search failed
+  return false;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GREEDY_SEARCH_H
+#define GREEDY_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Greedy best-first search on the heuristic cost alone. Every state is
+// queued at most once, first come first served among equal costs.
+//
+// With options.preferred, the children reached by helpful actions (see
+// RelaxedPlanCost) are also queued in a second open list. The lists take
+// turns, except that the preferred list gets options.preferred_boost extra
+// turns whenever a lower heuristic cost than any before is found. The cost of
+// the relaxed plan is then the heuristic cost, evaluated as with
+// options.deferred, and h is only evaluated for the initial state.
+//
+// With options.deferred, children are queued with their parent's heuristic
+// cost and only evaluated when expanded, so a node's heuristic cost is its
+// parent's until then.
+//
+// this function will take ownership of initial_state
+bool GreedySearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // GREEDY_SEARCH_H
@@ -32,7 +32,7 @@ namespace gripper {
 
 using namespace std;
 
-bool Gripper(bool verbose, bool input_file, float discount) {
+bool Gripper(bool input_file, float discount, const SearchOptions &options) {
   // operator names
   const int kMove = StringRegistry::Get()->GetInt("move");
   const int kPick = StringRegistry::Get()->GetInt("pick");
@@ -50,6 +50,31 @@ bool Gripper(bool verbose, bool input_file, float discount) {
   int room = 0;
   vector<int> ball_locs = {0};
   vector<int> gripper_holding {-1};
+  vector<int> ball_goals = {1};
+
+  if (input_file) {
+    // rooms, balls and grippers, the robot's room, the room of every ball
+    // and the goal room of every ball (-1 for none); all grippers start free
+    if (!(cin >> num_rooms >> num_balls >> num_grippers >> room) || num_rooms <= 0 || num_balls < 0 || num_grippers < 0) {
+      cout << "Invalid domain description file format" << endl;
+      return false;
+    }
+    ball_locs.assign(num_balls, 0);
+    ball_goals.assign(num_balls, -1);
+    gripper_holding.assign(num_grippers, -1);
+    for (int &loc : ball_locs) {
+      if (!(cin >> loc) || loc < 0 || loc >= num_rooms) {
+        cout << "Invalid domain description file format" << endl;
+        return false;
+      }
+    }
+    for (int &loc : ball_goals) {
+      if (!(cin >> loc) || loc >= num_rooms) {
+        cout << "Invalid domain description file format" << endl;
+        return false;
+      }
+    }
+  }
 
   assert(ball_locs.size() == num_balls);
   assert(gripper_holding.size() == num_grippers);
@@ -77,7 +102,12 @@ bool Gripper(bool verbose, bool input_file, float discount) {
   }
 
   // goal state
-  unique_ptr<State> goal_state(new State({Fluent(kAt, {0}, 1, 1.f)}));
+  unique_ptr<State> goal_state(new State(vector<Fluent>()));
+  for (int ball = 0; ball < num_balls; ball++) {
+    if (ball_goals[ball] >= 0) {
+      goal_state -> Add(Fluent(kAt, {ball}, ball_goals[ball], 1.f));
+    }
+  }
   const vector<const State*> goal_set = {goal_state.get()};
   
   
@@ -86,7 +116,7 @@ bool Gripper(bool verbose, bool input_file, float discount) {
   unique_ptr<Operator> place_op(new PlaceOperator(kPlace));
   const vector<const ::Operator*> operators = {move_op.get(), pick_op.get(), place_op.get()};
 
-  return Search(move(start_state), goal_set, operators, env, HZero(), verbose);
+  return Search(move(start_state), goal_set, operators, env, HZero(), options);
 }
 
 } // namespace gripper
@@ -17,9 +17,11 @@
 #ifndef GRIPPER_CONTEXT_H
 #define GRIPPER_CONTEXT_H
 
+#include "search_options.h"
+
 namespace gripper {
 
-bool Gripper(bool verbose, bool input_file, float discount);
+bool Gripper(bool input_file, float discount, const SearchOptions &options);
 
 } // namespace gripper
 
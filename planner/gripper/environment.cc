@@ -15,6 +15,7 @@
  */
 
 #include "environment.h"
+#include "string_registry.h"
 
 namespace gripper {
 
@@ -36,4 +37,19 @@ int Environment::GetNumGrippers() const {
   return num_grippers_;
 }
 
+void Environment::GetObjectTypes(vector<ObjectType> *types) const {
+  const int kAt = StringRegistry::Get()->GetInt("at");
+  const int kFree = StringRegistry::Get()->GetInt("free");
+  const int kCarry = StringRegistry::Get()->GetInt("carry");
+
+  types->push_back({num_balls_, {{kAt, 0}, {kCarry, -1}}});
+  types->push_back({num_grippers_, {{kCarry, 0}, {kFree, -1}}});
+}
+
+void Environment::GetParameters(vector<int> *parameters) const {
+  parameters->push_back(num_rooms_);
+  parameters->push_back(num_balls_);
+  parameters->push_back(num_grippers_);
+}
+
 } // namespace gripper
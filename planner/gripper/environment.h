@@ -33,6 +33,10 @@ class Environment : public ::Environment {
 
   int GetNumGrippers() const;
 
+  void GetObjectTypes(std::vector<ObjectType> *types) const override;
+
+  void GetParameters(std::vector<int> *parameters) const override;
+
  private:
   int num_rooms_;
   int num_balls_;
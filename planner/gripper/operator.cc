@@ -31,18 +31,15 @@ using namespace std;
 MoveOperator::MoveOperator(int name) : Operator(name) {}
 
 void MoveOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kMove = StringRegistry::Get()->GetInt("move");
-  const int kAtRobby = StringRegistry::Get()->GetInt("at_robby");
-
   for (int from_room = 0; from_room < env.GetNumRooms(); from_room++) {
     // robot is in from_room
-    if (state.GetProb(Fluent(kAtRobby, {}, from_room)) == 1.f) {
+    if (state.GetProb(Fluent(at_robby_, {}, from_room)) == 1.f) {
       for (int to_room = 0; to_room < env.GetNumRooms(); to_room++) {
         if (to_room != from_room) {
           const vector<Fluent> preconditions{};
-          const vector<Fluent> add_list{Fluent(kAtRobby, {}, to_room, 1.f)};
-          const vector<Fluent> delete_list{Fluent(kAtRobby, {}, from_room, 1.f)};
-          actions->emplace_back(new Action(kMove, 1.f, add_list, delete_list, {from_room, to_room}));
+          const vector<Fluent> add_list{Fluent(at_robby_, {}, to_room, 1.f)};
+          const vector<Fluent> delete_list{Fluent(at_robby_, {}, from_room, 1.f)};
+          actions->emplace_back(new Action(name_, 1.f, preconditions, add_list, delete_list, {from_room, to_room}));
         }
       }
     break;
@@ -55,26 +52,20 @@ void MoveOperator::ApplicableActions(const State &state, const Environment &env,
 PickOperator::PickOperator(int name) : Operator(name) {}
 
 void PickOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kPick = StringRegistry::Get()->GetInt("pick");
-  const int kAtRobby = StringRegistry::Get()->GetInt("at_robby");
-  const int kCarry = StringRegistry::Get()->GetInt("carry");
-  const int kAt = StringRegistry::Get()->GetInt("at");
-  const int kFree = StringRegistry::Get()->GetInt("free");
-
   for (int room = 0; room < env.GetNumRooms(); room++) {
     // robot is in room
-    if (state.GetProb(Fluent(kAtRobby, {}, room)) == 1.f) {
+    if (state.GetProb(Fluent(at_robby_, {}, room)) == 1.f) {
       for (int ball = 0; ball < env.GetNumBalls(); ball++) {
         // ball is in room
-        if (state.GetProb(Fluent(kAt, {ball}, room)) == 1.f) {
+        if (state.GetProb(Fluent(at_, {ball}, room)) == 1.f) {
           for (int gripper = 0; gripper < env.GetNumGrippers(); gripper++) {
             // gripper is free
-            if (state.GetProb(Fluent(kFree, {}, gripper)) == 1.f) {
-              const vector<Fluent> preconditions{};
-              const vector<Fluent> add_list{Fluent(kCarry, {gripper}, ball, 1.f)};
-              const vector<Fluent> delete_list{Fluent(kAt, {ball}, room, 1.f),
-                                               Fluent(kFree, {}, gripper, 1.f)};
-              actions->emplace_back(new Action(kPick, 1.f, add_list, delete_list, {ball, gripper}));
+            if (state.GetProb(Fluent(free_, {}, gripper)) == 1.f) {
+              const vector<Fluent> preconditions{Fluent(at_robby_, {}, room, 1.f)};
+              const vector<Fluent> add_list{Fluent(carry_, {gripper}, ball, 1.f)};
+              const vector<Fluent> delete_list{Fluent(at_, {ball}, room, 1.f),
+                                               Fluent(free_, {}, gripper, 1.f)};
+              actions->emplace_back(new Action(name_, 1.f, preconditions, add_list, delete_list, {ball, gripper}));
             }
           }
         }
@@ -89,24 +80,18 @@ void PickOperator::ApplicableActions(const State &state, const Environment &env,
 PlaceOperator::PlaceOperator(int name) : Operator(name) {}
 
 void PlaceOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kPlace = StringRegistry::Get()->GetInt("place");
-  const int kAtRobby = StringRegistry::Get()->GetInt("at_robby");
-  const int kAt = StringRegistry::Get()->GetInt("at");
-  const int kFree = StringRegistry::Get()->GetInt("free");
-  const int kCarry = StringRegistry::Get()->GetInt("carry");
-
   for (int room = 0; room < env.GetNumRooms(); room++) {
     // robot is in room
-    if (state.GetProb(Fluent(kAtRobby, {}, room)) == 1.f) {
+    if (state.GetProb(Fluent(at_robby_, {}, room)) == 1.f) {
       for (int gripper = 0; gripper < env.GetNumGrippers(); gripper++) {
         for (int ball = 0; ball < env.GetNumBalls(); ball++) {
           // robot is holding ball
-          if (state.GetProb(Fluent(kCarry, {gripper}, ball)) == 1.f) {
-            const vector<Fluent> preconditions{};
-            const vector<Fluent> add_list{Fluent(kAt, {ball}, room, 1.f),
-                                             Fluent(kFree, {}, gripper, 1.f)};
-            const vector<Fluent> delete_list{Fluent(kCarry, {gripper}, ball, 1.f)};
-            actions->emplace_back(new Action(kPlace, 1.f, add_list, delete_list, {ball, gripper}));
+          if (state.GetProb(Fluent(carry_, {gripper}, ball)) == 1.f) {
+            const vector<Fluent> preconditions{Fluent(at_robby_, {}, room, 1.f)};
+            const vector<Fluent> add_list{Fluent(at_, {ball}, room, 1.f),
+                                             Fluent(free_, {}, gripper, 1.f)};
+            const vector<Fluent> delete_list{Fluent(carry_, {gripper}, ball, 1.f)};
+            actions->emplace_back(new Action(name_, 1.f, preconditions, add_list, delete_list, {ball, gripper}));
           }
         }
       }
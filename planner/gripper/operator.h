@@ -35,6 +35,13 @@ class Operator : public ::Operator {
 
   virtual void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const = 0;
 
+ protected:
+  // registry ids of the predicates, looked up once when the operator is built
+  const int at_robby_ = StringRegistry::Get()->GetInt("at_robby");
+  const int at_ = StringRegistry::Get()->GetInt("at");
+  const int carry_ = StringRegistry::Get()->GetInt("carry");
+  const int free_ = StringRegistry::Get()->GetInt("free");
+
 };
 
 class MoveOperator : public Operator {
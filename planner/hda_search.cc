@@ -0,0 +1,356 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "hda_search.h"
+#include "open_list.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+typedef unordered_map<const State*, const SearchNode*, StatePtrHash, StatePtrEqual> BestNodes;
+
+// child sent to the thread that owns its state
+struct Message {
+  unique_ptr<State> state;
+  const SearchNode *parent;
+  unique_ptr<Action> action;
+  Message *next;
+};
+
+// Lock-free queue with many producers and a single consumer. Producers link
+// messages onto the head, and the consumer takes the whole list at once, so
+// there is no pop that could race with a push.
+class Inbox {
+ public:
+  Inbox() : head_(nullptr) {}
+
+  ~Inbox() {
+    Message *message = head_.load();
+    while (message != nullptr) {
+      Message *next = message->next;
+      delete message;
+      message = next;
+    }
+  }
+
+  void Push(Message *message) {
+    message->next = head_.load(memory_order_relaxed);
+    while (!head_.compare_exchange_weak(message->next, message, memory_order_release, memory_order_relaxed)) {}
+  }
+
+  // every queued message in the order it was pushed, nullptr if none
+  Message* PopAll() {
+    Message *message = head_.exchange(nullptr, memory_order_acquire);
+    Message *reversed = nullptr;
+    while (message != nullptr) {
+      Message *next = message->next;
+      message->next = reversed;
+      reversed = message;
+      message = next;
+    }
+    return reversed;
+  }
+
+ private:
+  atomic<Message*> head_;
+};
+
+// State shared by the threads of one search.
+//
+// Termination: a thread counts itself in num_idle while its open list and
+// inbox are empty, and leaves it before handling new messages. sent counts
+// messages pushed and received counts messages handled. The search is over
+// once received is read, every thread is then idle, and sent still equals
+// the received read first: no message was in flight or sent since.
+struct Shared {
+  Shared(int num_threads) : inboxes(num_threads), num_idle(0), sent(0), received(0), done(false), interrupted(false), incumbent(nullptr), incumbent_goal(nullptr), incumbent_cost(numeric_limits<float>::infinity()) {}
+
+  vector<Inbox> inboxes;
+  atomic<int> num_idle;
+  atomic<long> sent;
+  atomic<long> received;
+  atomic<bool> done;
+  atomic<bool> interrupted; // some thread saw options.Interrupted()
+
+  mutex incumbent_mutex; // guards incumbent and incumbent_goal
+  const SearchNode *incumbent; // cheapest goal node found
+  const State *incumbent_goal; // goal it satisfies
+  atomic<float> incumbent_cost; // weighted cost of incumbent
+};
+
+// One thread of the search, owning the nodes of its states.
+class Worker {
+ public:
+  Worker(int id, int num_threads, Shared *shared, unique_ptr<OpenList> open, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, const SearchOptions &options) : id_(id), num_threads_(num_threads), shared_(shared), open_(move(open)), goal_set_(goal_set), operators_(operators), h_(h), env_(env), options_(options), count_visited_(0), count_expanded_(0), count_prev_expanded_(0), count_duplicates_(0), count_pruned_(0), best_partial_(nullptr) {}
+
+  // thread owning state
+  static int Owner(const State &state, int num_threads) {
+    // spread the bits of the xor of the fluent hashes before taking modulo
+    return static_cast<int>(((state.Hash() * 0x9e3779b97f4a7c15ull) >> 32) % num_threads);
+  }
+
+  void AddRoot(unique_ptr<const State> state, unique_ptr<const Action> action, float heuristic_cost) {
+    visited_.emplace_back(new SearchNode(move(state), nullptr, move(action), heuristic_cost, ++count_visited_, options_.weight));
+    best_nodes_[visited_.back()->GetState()] = visited_.back().get();
+    open_->push(visited_.back().get());
+  }
+
+  void Run() {
+    bool idle = false;
+    while (!shared_->done) {
+      if (options_.Interrupted()) {
+        shared_->interrupted = true;
+        shared_->done = true;
+        break;
+      }
+      Message *message = shared_->inboxes[id_].PopAll();
+      if (message != nullptr && idle) {
+        idle = false;
+        shared_->num_idle--;
+      }
+      while (message != nullptr) {
+        Message *next = message->next;
+        Receive(move(message->state), message->parent, move(message->action));
+        delete message;
+        shared_->received++;
+        message = next;
+      }
+
+      if (!open_->empty()) {
+        Expand(open_->pop());
+      } else {
+        if (!idle) {
+          idle = true;
+          shared_->num_idle++;
+        }
+        const long received = shared_->received;
+        if (shared_->num_idle == num_threads_ && shared_->sent == received) {
+          shared_->done = true;
+        } else {
+          this_thread::yield();
+        }
+      }
+    }
+  }
+
+  int count_visited() const { return count_visited_; }
+  int count_expanded() const { return count_expanded_; }
+  int count_prev_expanded() const { return count_prev_expanded_; }
+  int count_duplicates() const { return count_duplicates_; }
+  int count_pruned() const { return count_pruned_; }
+  const SearchNode* best_partial() const { return best_partial_; }
+
+ private:
+  void Expand(const SearchNode *node) {
+    const State *state = node->GetState();
+    if (best_nodes_[state] != node || expanded_.count(state) > 0) {
+      count_prev_expanded_++;
+      return;
+    }
+    if (node->GetWeightedCost() >= shared_->incumbent_cost) {
+      count_pruned_++;
+      return;
+    }
+    expanded_.insert(state);
+    count_expanded_++;
+    if (best_partial_ == nullptr || node->GetHeuristicCost() < best_partial_->GetHeuristicCost()) {
+      best_partial_ = node;
+    }
+
+    const State *goal_state = SatisfiedGoal(goal_set_, *state);
+    if (goal_state != nullptr) {
+      lock_guard<mutex> lock(shared_->incumbent_mutex);
+      if (shared_->incumbent == nullptr || node->GetWeightedCost() < shared_->incumbent_cost || (node->GetWeightedCost() == shared_->incumbent_cost && node->GetParentActionCost() < shared_->incumbent->GetParentActionCost())) {
+        shared_->incumbent = node;
+        shared_->incumbent_goal = goal_state;
+        shared_->incumbent_cost = node->GetWeightedCost();
+      }
+      return;
+    }
+
+    vector<unique_ptr<Action>> actions;
+    node->Actions(operators_, env_, &actions);
+    for (unique_ptr<Action> &action : actions) {
+      unique_ptr<State> new_state = node->CreateSuccessor(*action, false);
+      if (new_state->Hash() == state->Hash() && new_state->ApproximatelyEquals(state) && state->ApproximatelyEquals(new_state.get())) {
+        count_duplicates_++;
+        continue;
+      }
+      const int owner = Owner(*new_state, num_threads_);
+      if (owner == id_) {
+        Receive(move(new_state), node, move(action));
+      } else {
+        Message *message = new Message;
+        message->state = move(new_state);
+        message->parent = node;
+        message->action = move(action);
+        shared_->sent++;
+        shared_->inboxes[owner].Push(message);
+      }
+    }
+  }
+
+  // queues a child of parent whose state this thread owns, unless it is a
+  // duplicate or no cheaper than the incumbent
+  void Receive(unique_ptr<State> state, const SearchNode *parent, unique_ptr<Action> action) {
+    if (!options_.reopen && expanded_.count(state.get()) > 0) {
+      count_duplicates_++;
+      return;
+    }
+    const float path_cost = parent->GetParentActionCost() + action->GetCost();
+    BestNodes::iterator best = best_nodes_.find(state.get());
+    float heuristic_cost;
+    if (best == best_nodes_.end()) {
+      heuristic_cost = HeuristicCost(h_, *state, goal_set_, operators_, env_);
+    } else if (path_cost < best->second->GetParentActionCost()) {
+      heuristic_cost = best->second->GetHeuristicCost();
+    } else {
+      count_duplicates_++;
+      return;
+    }
+    if (path_cost * options_.weight + heuristic_cost * (1.f - options_.weight) >= shared_->incumbent_cost) {
+      count_pruned_++;
+      return;
+    }
+
+    visited_.emplace_back(new SearchNode(move(state), parent, move(action), heuristic_cost, ++count_visited_, options_.weight));
+    const SearchNode *child = visited_.back().get();
+    if (best != best_nodes_.end()) {
+      // cheaper than the earlier node for the state, reopen
+      expanded_.erase(child->GetState());
+      best_nodes_.erase(best);
+    }
+    best_nodes_[child->GetState()] = child;
+    open_->push(child);
+  }
+
+  const int id_;
+  const int num_threads_;
+  Shared *shared_;
+  unique_ptr<OpenList> open_;
+  const vector<const State*> &goal_set_;
+  const vector<const Operator*> &operators_;
+  const Heuristic &h_;
+  const Environment &env_;
+  const SearchOptions &options_;
+
+  vector<unique_ptr<SearchNode>> visited_;
+  StateSet expanded_;
+  BestNodes best_nodes_;
+
+  int count_visited_;
+  int count_expanded_;
+  int count_prev_expanded_;
+  int count_duplicates_;
+  int count_pruned_;
+  // expanded node with the lowest heuristic cost, for an interrupted search
+  const SearchNode *best_partial_;
+};
+
+} // namespace
+
+bool HDASearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  if (options.max_nodes > 0 || options.max_memory_mb > 0) {
+    cerr << "memory bounds are not supported with more than one thread" << endl;
+    return false;
+  }
+  if (options.dominance) {
+    cout << "dominance pruning is not done with more than one thread, ignoring it" << endl;
+  }
+  if (options.partial_order) {
+    cout << "partial order reduction is not done with more than one thread, ignoring it" << endl;
+  }
+  if (options.batch_size > 1) {
+    cout << "batches are not expanded with more than one thread, ignoring the batch size" << endl;
+  }
+
+  const int num_threads = options.threads;
+  Shared shared(num_threads);
+  vector<unique_ptr<Worker>> workers;
+  for (int i = 0; i < num_threads; ++i) {
+    unique_ptr<OpenList> open = CreateOpenList(options, goal_set, operators, env);
+    if (open == nullptr) {
+      cerr << "invalid open list " << options.open_list << endl;
+      return false;
+    }
+    workers.emplace_back(new Worker(i, num_threads, &shared, move(open), goal_set, operators, h, env, options));
+  }
+
+  const float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  const int owner = Worker::Owner(*initial_state, num_threads);
+  workers[owner]->AddRoot(move(initial_state), unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost);
+
+  vector<thread> threads;
+  for (unique_ptr<Worker> &worker : workers) {
+    threads.emplace_back(&Worker::Run, worker.get());
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_prev_expanded = 0;
+  int count_duplicates = 0;
+  int count_pruned = 0;
+  cout << "nodes expanded by thread:";
+  for (const unique_ptr<Worker> &worker : workers) {
+    cout << " " << worker->count_expanded();
+    count_visited += worker->count_visited();
+    count_expanded += worker->count_expanded();
+    count_prev_expanded += worker->count_prev_expanded();
+    count_duplicates += worker->count_duplicates();
+    count_pruned += worker->count_pruned();
+  }
+  cout << endl;
+
+  // the nodes in the path belong to several workers, which are still alive
+  if (shared.interrupted && shared.incumbent == nullptr) {
+    const SearchNode *best_partial = nullptr;
+    for (const unique_ptr<Worker> &worker : workers) {
+      if (worker->best_partial() != nullptr && (best_partial == nullptr || worker->best_partial()->GetHeuristicCost() < best_partial->GetHeuristicCost())) {
+        best_partial = worker->best_partial();
+      }
+    }
+    if (best_partial != nullptr) {
+      ReturnInterruptedPlan(*best_partial, count_expanded, "the expanded node with the lowest heuristic cost", best_partial->GetHeuristicCost(), options, path, costs);
+    }
+    return false;
+  }
+  if (shared.interrupted && !options.quiet) {
+    cout << "search interrupted, the goal found so far may not be the cheapest" << endl;
+  }
+  if (shared.incumbent == nullptr) {
+    cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped" << endl;
+    return false;
+  }
+  cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped, " << count_pruned << " nodes pruned by the incumbent, solution cost: " << shared.incumbent->GetCost() << endl;
+  cout << "satisfies goal state " << *shared.incumbent_goal << endl;
+  shared.incumbent->GetPath(path);
+  shared.incumbent->GetCosts(costs);
+  return true;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HDA_SEARCH_H
+#define HDA_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Hash distributed best-first search (HDA*) on options.threads threads.
+//
+// Every thread owns the states whose hash maps to it, together with their
+// open list and closed set. Children are sent to the thread that owns their
+// state through a lock-free queue, and the owner drops duplicates before
+// evaluating the heuristic. A goal node found by any thread becomes the
+// incumbent, and the threads stop expanding nodes whose weighted cost is not
+// below the incumbent's. The search ends when every thread is out of work
+// and no child is in flight. With weight 0 this returns about as soon as a
+// goal is found, like UCSearch.
+//
+// Every thread checks options.Interrupted() before its next expansion. An
+// interrupted search returns the cheapest goal found so far, or else false
+// with the path to the expanded node with the lowest heuristic cost.
+//
+// this function will take ownership of initial_state
+bool HDASearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // HDA_SEARCH_H
@@ -14,27 +14,21 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <unordered_map>
 
 #include "heuristic.h"
 #include "uc_search.h"
 
 using namespace std;
 
-// no heuristic (always 0)
-float HZero::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
-  return 0.f;
-}
-
-// computationally cheap, underestimating heuristic
-float HMax::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
-  unique_ptr<State> new_state(new State(initial_state));
-  if (goal_state.SatisfiedBy(new_state.get())) {
-    return 0.f;
-  }
+namespace {
 
+float MinBaseCost(const vector<const Operator*> &operators) {
   float base_cost = -1.f;
   for (const Operator* o : operators) {
     if (base_cost < 0.f) {
@@ -43,68 +37,259 @@ float HMax::Cost(const State &initial_state, const State &goal_state, const vect
       base_cost = o->GetBaseCost();
     }
   }
+  return base_cost;
+}
+
+// Layered add-only relaxation from initial_state, shared by HMax and HHSP so
+// that every goal in goal_set is read off one exploration. The max cost of a
+// goal is base_cost * the first layer that satisfies it; the additive cost
+// charges base_cost * layer for every goal fluent first satisfied in that
+// layer. With min_only the exploration stops once no unsatisfied goal can be
+// cheaper than the cheapest satisfied one. Goals that are not reached are left
+// at infinity.
+void RelaxedGoalCosts(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env, bool additive, bool min_only, vector<float> *costs) {
+  const float kInfinity = numeric_limits<float>::infinity();
+  costs->assign(goal_set.size(), kInfinity);
+
+  // buffers kept per thread so that concurrent evaluations (see eval_pool.h)
+  // neither share nor reallocate them on every call
+  thread_local vector<int> prev_satisfied;
+  thread_local vector<float> partial_costs;
+  thread_local vector<unique_ptr<Action>> actions;
+  prev_satisfied.assign(goal_set.size(), 0);
+  partial_costs.assign(goal_set.size(), 0.f);
+  int num_unsatisfied = 0;
+  float min_cost = kInfinity;
+  for (int i = 0; i < goal_set.size(); ++i) {
+    if (goal_set[i]->SatisfiedBy(&initial_state)) {
+      (*costs)[i] = 0.f;
+      min_cost = 0.f;
+    } else {
+      prev_satisfied[i] = goal_set[i]->NumSatisfiedBy(&initial_state);
+      num_unsatisfied++;
+    }
+  }
+  if (num_unsatisfied == 0 || (min_only && min_cost == 0.f)) {
+    return;
+  }
 
+  const float base_cost = MinBaseCost(operators);
+  unique_ptr<State> new_state(new State(initial_state));
   int depth = 0;
 
-  do {
-    vector<unique_ptr<Action>> actions;
+  while (true) {
+    State prev_state(*new_state);
+    actions.clear();
     for (const Operator* o : operators) {
-      o->ApplicableActions(*(new_state.get()), env, &actions); 
+      if (!o->IsMacro()) {
+        o->ApplicableActions(*(new_state.get()), env, &actions); 
+      }
     }
     for (unique_ptr<Action> &a : actions) {
       a->AddSuccessor(new_state.get());
     }
-
     depth++;
-  } while (!goal_state.SatisfiedBy(new_state.get()));
 
-  return depth * base_cost;
+    // cheapest cost any still unsatisfied goal could end up with
+    float min_bound = kInfinity;
+    for (int i = 0; i < goal_set.size(); ++i) {
+      if ((*costs)[i] < kInfinity) {
+        continue;
+      }
+      int num_satisfied = goal_set[i]->NumSatisfiedBy(new_state.get());
+      partial_costs[i] += (num_satisfied - prev_satisfied[i]) * base_cost * depth;
+      prev_satisfied[i] = num_satisfied;
+      if (goal_set[i]->SatisfiedBy(new_state.get())) {
+        (*costs)[i] = additive ? partial_costs[i] : depth * base_cost;
+        min_cost = min(min_cost, (*costs)[i]);
+        num_unsatisfied--;
+      } else if (additive) {
+        min_bound = min(min_bound, partial_costs[i] + (goal_set[i]->GetFluents().size() - num_satisfied) * base_cost * (depth + 1));
+      } else {
+        min_bound = min(min_bound, (depth + 1) * base_cost);
+      }
+    }
+
+    if (num_unsatisfied == 0 || (min_only && min_cost <= min_bound) || *new_state == prev_state) {
+      return;
+    }
+  }
 }
 
-// computationally cheap, usually overestimating heuristic
-float HHSP::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
-  unique_ptr<State> new_state(new State(initial_state));
-  if (goal_state.SatisfiedBy(new_state.get())) {
-    return 0.f;
+float MinOf(const vector<float> &costs) {
+  return *min_element(costs.begin(), costs.end());
+}
+
+} // namespace
+
+void Heuristic::GoalCosts(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env, vector<float> *costs) const {
+  costs->clear();
+  for (const State *goal_state : goal_set) {
+    costs->push_back(Cost(initial_state, *goal_state, operators, env));
   }
+}
 
-  float base_cost = -1.f;
-  for (const Operator* o : operators) {
-    if (base_cost < 0.f) {
-      base_cost = o->GetBaseCost();
-    } else if (o->GetBaseCost() < base_cost) {
-      base_cost = o->GetBaseCost();
+float Heuristic::MinCost(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
+  float cost = Cost(initial_state, *goal_set[0], operators, env);
+  for (int i = 1; i < goal_set.size(); i++) {
+    float cmp_cost = Cost(initial_state, *goal_set[i], operators, env);
+    if (cmp_cost < cost) {
+      cost = cmp_cost;
     }
   }
+  return cost;
+}
 
-  float cost = 0.f;
-  int prev_satisfied = goal_state.NumSatisfiedBy(&initial_state);
-  int depth = 0;
+// no heuristic (always 0)
+float HZero::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
+  return 0.f;
+}
 
-  do {
-    vector<unique_ptr<Action>> actions;
-    for (const Operator* o : operators) {
-      o->ApplicableActions(*(new_state.get()), env, &actions); 
-    }
-    for (unique_ptr<Action> &a : actions) {
-      a->AddSuccessor(new_state.get());
-    }
+float HZero::MinCost(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
+  return 0.f;
+}
 
-    depth++;
-    int num_satisfied = goal_state.NumSatisfiedBy(new_state.get());
-    cost += (num_satisfied - prev_satisfied) * base_cost * depth;
-    prev_satisfied = num_satisfied;
-  } while (!goal_state.SatisfiedBy(new_state.get()));
+// computationally cheap, underestimating heuristic
+float HMax::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
+  return MinCost(initial_state, {&goal_state}, operators, env);
+}
 
-  return cost;
+void HMax::GoalCosts(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env, vector<float> *costs) const {
+  RelaxedGoalCosts(initial_state, goal_set, operators, env, false, false, costs);
+}
+
+float HMax::MinCost(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
+  vector<float> costs;
+  RelaxedGoalCosts(initial_state, goal_set, operators, env, false, true, &costs);
+  return MinOf(costs);
+}
+
+// computationally cheap, usually overestimating heuristic
+float HHSP::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
+  return MinCost(initial_state, {&goal_state}, operators, env);
+}
+
+void HHSP::GoalCosts(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env, vector<float> *costs) const {
+  RelaxedGoalCosts(initial_state, goal_set, operators, env, true, false, costs);
+}
+
+float HHSP::MinCost(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
+  vector<float> costs;
+  RelaxedGoalCosts(initial_state, goal_set, operators, env, true, true, &costs);
+  return MinOf(costs);
 }
 
 // computationally expensive, underestimating heuristic
 float HFF::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
+  return MinCost(initial_state, {&goal_state}, operators, env);
+}
+
+float HFF::MinCost(const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
   unique_ptr<State> new_state(new State(initial_state));
   float cost = 0.f;
-  unique_ptr<State> goal_state_ptr(new State(goal_state));
-  const vector<const State*> goal_set = {goal_state_ptr.get()};
-  UCSearch(move(new_state), goal_set, operators, HMax(), env, nullptr, nullptr, &cost, true, false, 0.f, 0.f);
+  UCSearch(move(new_state), goal_set, operators, HMax(), env, nullptr, nullptr, &cost, true, SearchOptions());
+  return cost;
+}
+
+float RelaxedPlanCost(const State &state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env, vector<unique_ptr<Action>> *helpful) {
+  // forward: the states of the relaxation and the actions applicable in each
+  vector<unique_ptr<State>> layers;
+  vector<vector<unique_ptr<Action>>> layer_actions;
+  layers.emplace_back(new State(state));
+  const State *goal = nullptr;
+  while (true) {
+    for (const State *goal_state : goal_set) {
+      if (goal_state->SatisfiedBy(layers.back().get())) {
+        goal = goal_state;
+        break;
+      }
+    }
+    if (goal != nullptr) {
+      break;
+    }
+    layer_actions.emplace_back();
+    for (const Operator *o : operators) {
+      if (!o->IsMacro()) {
+        o->ApplicableActions(*layers.back(), env, &layer_actions.back());
+      }
+    }
+    unique_ptr<State> next(new State(*layers.back()));
+    for (const unique_ptr<Action> &a : layer_actions.back()) {
+      a->AddSuccessor(next.get());
+    }
+    if (*next == *layers.back()) {
+      return numeric_limits<float>::infinity();
+    }
+    layers.push_back(move(next));
+  }
+
+  // first layer in which f holds with at least its probability
+  auto first_layer = [&layers](const Fluent &f) {
+    int layer = 0;
+    while (layer + 1 < layers.size() && layers[layer]->GetProb(f) < f.GetProb()) {
+      ++layer;
+    }
+    return layer;
+  };
+  const FluentExcludingProbEqual same_fluent;
+  auto achieves = [&same_fluent](const Action &a, const Fluent &f) {
+    for (const Fluent &add : a.GetAddList()) {
+      if (same_fluent(add, f) && add.GetProb() >= f.GetProb()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // backward: subgoals are achieved by the cheapest action of the layer before
+  // the one where they first hold, unless an action chosen there already does
+  vector<vector<Fluent>> subgoals(layers.size());
+  vector<vector<bool>> chosen(layer_actions.size());
+  for (int layer = 0; layer < layer_actions.size(); ++layer) {
+    chosen[layer].assign(layer_actions[layer].size(), false);
+  }
+  for (const Fluent &f : goal->GetFluents()) {
+    subgoals[first_layer(f)].push_back(f);
+  }
+  float cost = 0.f;
+  for (int layer = layers.size() - 1; layer > 0; --layer) {
+    const vector<unique_ptr<Action>> &actions = layer_actions[layer - 1];
+    for (int g = 0; g < subgoals[layer].size(); ++g) {
+      const Fluent f = subgoals[layer][g];
+      int achiever = -1;
+      for (int i = 0; i < actions.size(); ++i) {
+        if (achieves(*actions[i], f)) {
+          if (chosen[layer - 1][i]) {
+            achiever = -1;
+            break;
+          }
+          if (achiever < 0 || actions[i]->GetCost() < actions[achiever]->GetCost()) {
+            achiever = i;
+          }
+        }
+      }
+      if (achiever < 0) {
+        continue;
+      }
+      chosen[layer - 1][achiever] = true;
+      cost += actions[achiever]->GetCost();
+      for (const vector<Fluent> *reads : {&actions[achiever]->GetPreconditions(), &actions[achiever]->GetDeleteList()}) {
+        for (const Fluent &p : *reads) {
+          subgoals[first_layer(p)].push_back(p);
+        }
+      }
+    }
+  }
+
+  if (helpful != nullptr && layers.size() > 1) {
+    for (unique_ptr<Action> &a : layer_actions[0]) {
+      for (const Fluent &f : subgoals[1]) {
+        if (achieves(*a, f)) {
+          helpful->push_back(move(a));
+          break;
+        }
+      }
+    }
+  }
   return cost;
 }
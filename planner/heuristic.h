@@ -17,6 +17,9 @@
 #ifndef HEURISTIC_H
 #define HEURISTIC_H
 
+#include <memory>
+#include <vector>
+
 #include "support.h"
 #include "operator.h"
 
@@ -24,31 +27,58 @@ class Heuristic {
  public:
   virtual ~Heuristic() {}
   virtual float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const = 0;
+
+  // Cost to each goal in goal_set. The default calls Cost once per goal.
+  virtual void GoalCosts(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env, std::vector<float> *costs) const;
+
+  // Cost to the cheapest goal in goal_set. The default calls Cost once per goal.
+  virtual float MinCost(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const;
 };
 
 // no heuristic (always 0)
 class HZero : public Heuristic {
  public:
   float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const override;
-  
+
+  float MinCost(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const override;
 };
 
 // computationally cheap, underestimating heuristic
+// (all goals are read off a single relaxed exploration)
 class HMax : public Heuristic {
  public:
   float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const override;
+
+  void GoalCosts(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env, std::vector<float> *costs) const override;
+
+  float MinCost(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const override;
 };
 
 // computationally cheap, usually overestimating heuristic
+// (all goals are read off a single relaxed exploration)
 class HHSP : public Heuristic {
  public:
   float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const override;
+
+  void GoalCosts(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env, std::vector<float> *costs) const override;
+
+  float MinCost(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const override;
 };
 
 // computationally expensive, underestimating heuristic
+// (MinCost runs one relaxed search towards the whole goal set)
 class HFF : public Heuristic {
  public:
   float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const override;
+
+  float MinCost(const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const override;
 };
 
+// Extracts a plan backwards from the layered add-only relaxation of state to
+// the first goal in goal_set that it reaches and returns the plan's cost
+// (infinity if no goal is reached). If helpful is not nullptr, the actions
+// applicable in state that achieve a subgoal of the plan's second layer (FF's
+// helpful actions) are moved into it.
+float RelaxedPlanCost(const State &state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env, std::vector<std::unique_ptr<Action>> *helpful);
+
 #endif  // HEURISTIC_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <unordered_set>
+
+#include "hill_climbing.h"
+#include "string_registry.h"
+
+using namespace std;
+
+bool HillClimbingSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  // for the complete search if the hill-climbing gets stuck
+  unique_ptr<const State> fallback_state(new State(*initial_state));
+
+  // nodes on the committed path, the initial node first
+  vector<unique_ptr<SearchNode>> committed;
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_climbs = 0;
+  int max_nodes_kept = 0;
+
+  float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  committed.emplace_back(new SearchNode(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, 0.f));
+  const SearchNode *current = committed.back().get();
+
+  while (SatisfiedGoal(goal_set, *current->GetState()) == nullptr) {
+    // breadth-first search from current for a lower heuristic cost or a goal
+    vector<unique_ptr<SearchNode>> visited;
+    StateSet seen;
+    seen.insert(current->GetState());
+    deque<const SearchNode*> queue;
+    queue.push_back(current);
+    const SearchNode *better = nullptr;
+
+    while (better == nullptr && !queue.empty()) {
+      if (options.Interrupted()) {
+        ReturnInterruptedPlan(*current, count_expanded, "the committed node with heuristic cost", current->GetHeuristicCost(), options, path, costs);
+        return false;
+      }
+
+      const SearchNode *node = queue.front();
+      queue.pop_front();
+      count_expanded++;
+
+      vector<unique_ptr<State>> new_states;
+      vector<unique_ptr<Action>> actions;
+      vector<float> heuristic_costs;
+      UnseenChildren(*node, goal_set, operators, &h, env, &seen, &new_states, &actions, &heuristic_costs);
+
+      for (int j = 0; j < new_states.size(); ++j) {
+        visited.emplace_back(new SearchNode(move(new_states[j]), node, move(actions[j]), heuristic_costs[j], ++count_visited, 0.f));
+        const SearchNode *child = visited.back().get();
+        if (better == nullptr && (child->GetHeuristicCost() < current->GetHeuristicCost() || SatisfiedGoal(goal_set, *child->GetState()) != nullptr)) {
+          better = child;
+        }
+        queue.push_back(child);
+      }
+    }
+    max_nodes_kept = max(max_nodes_kept, static_cast<int>(committed.size() + visited.size()));
+
+    if (better == nullptr) {
+      cout << "hill-climbing stuck at heuristic cost " << current->GetHeuristicCost() << " after " << count_climbs << " climbs and " << count_expanded << " nodes expanded, falling back to the complete search" << endl;
+      return UCSearch(move(fallback_state), goal_set, operators, h, env, path, costs, nullptr, false, options);
+    }
+
+    // keep only the nodes on the path from current to better
+    unordered_set<const SearchNode*> on_path;
+    for (const SearchNode *node = better; node != current; node = node->GetParent()) {
+      on_path.insert(node);
+    }
+    for (unique_ptr<SearchNode> &node : visited) {
+      if (on_path.count(node.get()) > 0) {
+        committed.push_back(move(node));
+      }
+    }
+    current = better;
+    count_climbs++;
+
+    if (!options.verbose && !options.quiet) {cout << "climb " << count_climbs << " to heuristic cost " << current->GetHeuristicCost() << ", " << count_expanded << " nodes expanded" << endl;}
+  }
+
+  cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_climbs << " climbs, at most " << max_nodes_kept << " nodes kept, solution cost: " << current->GetCost() << endl;
+  cout << "satisfies goal state " << *SatisfiedGoal(goal_set, *current->GetState()) << endl;
+  current->GetPath(path);
+  current->GetCosts(costs);
+  return true;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HILL_CLIMBING_H
+#define HILL_CLIMBING_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Enforced hill-climbing. From the current node, a breadth-first search looks
+// for a state with a lower heuristic cost than the current one (or a goal),
+// commits to the path to it and starts over from there. Only the committed
+// path and the nodes of the current breadth-first search are kept.
+//
+// When a breadth-first search runs out of states without getting any better,
+// the hill-climbing gives up and UCSearch is run from the initial state.
+//
+// this function will take ownership of initial_state
+bool HillClimbingSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // HILL_CLIMBING_H
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "ida_search.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+typedef unordered_map<const State*, float, StatePtrHash, StatePtrEqual> Table;
+
+// state shared by the depth-first searches of one IDASearch
+struct Iteration {
+  Iteration(const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, const SearchOptions &options) : goal_set(goal_set), operators(operators), h(h), env(env), options(options), bound(0.f), next_bound(0.f), count_visited(0), count_expanded(0), count_table_hits(0), best_heuristic_cost(numeric_limits<float>::infinity()), interrupted(false), goal_state(nullptr) {}
+
+  const vector<const State*> &goal_set;
+  const vector<const Operator*> &operators;
+  const Heuristic &h;
+  const Environment &env;
+  const SearchOptions &options;
+
+  float bound;
+  // cheapest weighted cost above the bound seen in this iteration
+  float next_bound;
+  int count_visited;
+  int count_expanded;
+  int count_table_hits;
+
+  // cheapest cost so far of the states remembered in this iteration
+  Table table;
+  vector<unique_ptr<State>> table_states;
+
+  // path to the node with the lowest heuristic cost, for an interrupted search
+  float best_heuristic_cost;
+  vector<SearchNode::PathPair> best_path;
+  vector<float> best_costs;
+  bool interrupted;
+  const State *goal_state;
+};
+
+// true if state is in the table at a cost no higher than cost, otherwise
+// remembers it at cost if there is room
+bool TableHit(const State &state, float cost, Iteration *iteration) {
+  if (iteration->options.ida_table_size <= 0) {
+    return false;
+  }
+  Table::iterator entry = iteration->table.find(&state);
+  if (entry != iteration->table.end()) {
+    if (entry->second <= cost) {
+      iteration->count_table_hits++;
+      return true;
+    }
+    entry->second = cost;
+  } else if (iteration->table.size() < iteration->options.ida_table_size) {
+    iteration->table_states.emplace_back(new State(state));
+    iteration->table[iteration->table_states.back().get()] = cost;
+  }
+  return false;
+}
+
+// depth-first search below node within the bound, fills in path and costs and
+// returns true once a goal is found
+bool DepthFirst(const SearchNode &node, Iteration *iteration, vector<SearchNode::PathPair> *path, vector<float> *costs) {
+  if (iteration->options.Interrupted()) {
+    iteration->interrupted = true;
+    return false;
+  }
+  iteration->goal_state = SatisfiedGoal(iteration->goal_set, *node.GetState());
+  if (iteration->goal_state != nullptr) {
+    node.GetPath(path);
+    node.GetCosts(costs);
+    return true;
+  }
+  if (node.GetHeuristicCost() < iteration->best_heuristic_cost) {
+    iteration->best_heuristic_cost = node.GetHeuristicCost();
+    iteration->best_path.clear();
+    iteration->best_costs.clear();
+    node.GetPath(&iteration->best_path);
+    node.GetCosts(&iteration->best_costs);
+  }
+  iteration->count_expanded++;
+
+  vector<unique_ptr<Action>> actions;
+  node.Actions(iteration->operators, iteration->env, &actions);
+
+  // (weighted cost, action index) of the children within the bound
+  vector<pair<float, int>> children;
+  vector<float> heuristic_costs(actions.size());
+  State scratch(*node.GetState());
+  for (int i = 0; i < actions.size(); ++i) {
+    scratch = *node.GetState();
+    actions[i]->Successor(&scratch);
+    if (node.InPath(scratch)) {
+      continue;
+    }
+    float cost = node.GetParentActionCost() + actions[i]->GetCost();
+    if (TableHit(scratch, cost, iteration)) {
+      continue;
+    }
+    heuristic_costs[i] = HeuristicCost(iteration->h, scratch, iteration->goal_set, iteration->operators, iteration->env);
+    iteration->count_visited++;
+    float weighted_cost = cost * node.GetWeight() + heuristic_costs[i] * (1.f - node.GetWeight());
+    if (weighted_cost > iteration->bound) {
+      iteration->next_bound = min(iteration->next_bound, weighted_cost);
+      continue;
+    }
+    children.emplace_back(weighted_cost, i);
+  }
+  sort(children.begin(), children.end());
+
+  for (const pair<float, int> &child : children) {
+    int i = child.second;
+    unique_ptr<State> new_state(new State(*node.GetState()));
+    actions[i]->Successor(new_state.get());
+    SearchNode child_node(move(new_state), &node, move(actions[i]), heuristic_costs[i], iteration->count_visited, node.GetWeight());
+    if (DepthFirst(child_node, iteration, path, costs)) {
+      return true;
+    }
+    if (iteration->interrupted) {
+      return false;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+bool IDASearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  if (options.weight <= 0.f) {
+    cerr << "IDA* needs a positive weight" << endl;
+    return false;
+  }
+
+  float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+  SearchNode root(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, 0, options.weight);
+
+  Iteration iteration(goal_set, operators, h, env, options);
+  iteration.next_bound = root.GetWeightedCost();
+  int count_iterations = 0;
+  while (iteration.next_bound < numeric_limits<float>::infinity()) {
+    iteration.bound = iteration.next_bound;
+    iteration.next_bound = numeric_limits<float>::infinity();
+    iteration.table.clear();
+    iteration.table_states.clear();
+    count_iterations++;
+
+    if (DepthFirst(root, &iteration, path, costs)) {
+      cout << "found goal state! " << iteration.count_expanded << " nodes expanded, " << iteration.count_visited << " nodes visited, " << count_iterations << " iterations, " << iteration.count_table_hits << " table hits, solution cost: " << costs->front() << endl;
+      cout << "satisfies goal state " << *iteration.goal_state << endl;
+      return true;
+    }
+    if (iteration.interrupted) {
+      if (!options.quiet) {cout << "search interrupted after " << iteration.count_expanded << " nodes expanded, returning the plan to the expanded node with the lowest heuristic cost " << iteration.best_heuristic_cost << endl;}
+      *path = move(iteration.best_path);
+      *costs = move(iteration.best_costs);
+      return false;
+    }
+    if (!options.verbose && !options.quiet) {cout << "iteration " << count_iterations << " with bound " << iteration.bound << " done, " << iteration.count_expanded << " nodes expanded, " << iteration.count_visited << " nodes visited" << endl;}
+  }
+
+  // search failed
+  return false;
+}
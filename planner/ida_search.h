@@ -0,0 +1,45 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IDA_SEARCH_H
+#define IDA_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Iterative deepening on the weighted cost (IDA*), for tight memory bounds.
+// Each iteration is a depth-first search that skips the children whose
+// weighted cost exceeds the bound, and the next iteration raises the bound to
+// the cheapest child skipped. options.weight must be positive, or path costs
+// would not bound the depth.
+//
+// Only the nodes on the current path are kept, and children are evaluated one
+// after the other in a single scratch state before the cheapest are visited.
+// States on the current path are not visited again. With
+// options.ida_table_size, up to that many states are remembered with their
+// cheapest cost so far in each iteration, so that transpositions reached at
+// no lower cost are skipped.
+//
+// this function will take ownership of initial_state
+bool IDASearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // IDA_SEARCH_H
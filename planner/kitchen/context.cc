@@ -32,7 +32,7 @@ namespace kitchen {
 
 using namespace std;
 
-bool Kitchen(bool verbose, bool input_file, float weight, float epsilon) {
+bool Kitchen(bool input_file, const SearchOptions &options) {
   // operator names
   const int kMove= StringRegistry::Get()->GetInt("move");
   const int kPick = StringRegistry::Get()->GetInt("pick");
@@ -964,12 +964,22 @@ bool Kitchen(bool verbose, bool input_file, float weight, float epsilon) {
   unique_ptr<Operator> look_hand_op(new LookHandOperator(kLookHand, look_prob, look_base_cost, look_cost_multiplier, log_cost));
   unique_ptr<Operator> look_obj_op(new LookObjOperator(kLookObj, look_prob, look_base_cost, look_cost_multiplier, log_cost));
 
-  const vector<const ::Operator*> operators = {move_op.get(), pick_op.get(), place_op.get(), look_robot_op.get(), look_hand_op.get(), look_obj_op.get()};
+  vector<const ::Operator*> operators = {move_op.get(), pick_op.get(), place_op.get(), look_robot_op.get(), look_hand_op.get(), look_obj_op.get()};
+  unique_ptr<Operator> look_obj_macro_op;
+  if (options.macro_looks) {
+    // repeated looks stop at the probabilities the goal asks for
+    vector<float> thresholds;
+    for (const Fluent &f : goal_fluents) {
+      thresholds.push_back(f.GetProb());
+    }
+    look_obj_macro_op.reset(new LookObjMacroOperator(kLookObj, look_prob, look_base_cost, look_cost_multiplier, log_cost, thresholds));
+    operators.push_back(look_obj_macro_op.get());
+  }
 
 
   //cout << *start_state.get() << endl;
   //cout << goal_state << endl;
-  return Search(move(start_state), goal_set, operators, env, HHSP(), verbose, epsilon, weight);
+  return Search(move(start_state), goal_set, operators, env, HHSP(), options);
 }
 
 } // namespace kitchen
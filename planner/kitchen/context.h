@@ -17,9 +17,11 @@
 #ifndef KITCHEN_CONTEXT_H
 #define KITCHEN_CONTEXT_H
 
+#include "search_options.h"
+
 namespace kitchen {
 
-bool Kitchen(bool verbose, bool file, float weight, float epsilon);
+bool Kitchen(bool file, const SearchOptions &options);
 
 } // namespace kitchen
 
@@ -15,6 +15,7 @@
  */
 
 #include "environment.h"
+#include "string_registry.h"
 
 namespace kitchen {
 
@@ -36,4 +37,45 @@ const std::vector<int>& Environment::GetStoveLocs() const {
   return stove_locs_;
 }
 
+void Environment::GetObjectTypes(vector<ObjectType> *types) const {
+  const int kBHeld = StringRegistry::Get()->GetInt("held");
+  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
+  const int kBCooked = StringRegistry::Get()->GetInt("cooked");
+
+  // held has value -1 when nothing is held
+  types->push_back({num_objs_, {{kBObjLoc, 0}, {kBHeld, -1}, {kBCooked, -1}}});
+}
+
+void Environment::GetParameters(vector<int> *parameters) const {
+  parameters->push_back(num_locs_);
+  parameters->push_back(num_objs_);
+  parameters->insert(parameters->end(), stove_locs_.begin(), stove_locs_.end());
+}
+
+void Environment::GetIrrelevantFluents(const State &start_state, const vector<const State*> &goal_set, vector<Fluent> *fluents) const {
+  const int kBConf = StringRegistry::Get()->GetInt("conf");
+  const int kBHeld = StringRegistry::Get()->GetInt("held");
+  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
+  const int kBCooked = StringRegistry::Get()->GetInt("cooked");
+
+  if (start_state.GetProb(Fluent(kBHeld, {}, -1)) < 1.f) {
+    return;
+  }
+  for (const State *goal_state : goal_set) {
+    for (const Fluent &f : goal_state->GetFluents()) {
+      if (f.GetPredicate() != kBConf && !(f.GetPredicate() == kBHeld && f.GetValue() == -1)) {
+        return;
+      }
+    }
+  }
+
+  for (int obj = 0; obj < num_objs_; ++obj) {
+    fluents->push_back(Fluent(kBHeld, {}, obj));
+    fluents->push_back(Fluent(kBCooked, {}, obj));
+    for (int loc = 0; loc < num_locs_; ++loc) {
+      fluents->push_back(Fluent(kBObjLoc, {obj}, loc));
+    }
+  }
+}
+
 } // namespace kitchen
@@ -32,6 +32,15 @@ class Environment : public ::Environment {
   int GetNumObjs() const;
 
   const std::vector<int>& GetStoveLocs() const;
+
+  void GetObjectTypes(std::vector<ObjectType> *types) const override;
+
+  void GetParameters(std::vector<int> *parameters) const override;
+
+  // when the goal only asks for robot locations and an empty hand, and the
+  // hand is surely empty, no object is worth picking: moving while holding
+  // one is only less likely to succeed
+  void GetIrrelevantFluents(const State &start_state, const std::vector<const State*> &goal_set, std::vector<Fluent> *fluents) const override;
  
  private:
   const int num_locs_;
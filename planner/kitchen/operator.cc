@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <cmath>
@@ -21,25 +22,30 @@
 #include "string_registry.h"
 #include "operator.h"
 
-//TODO: implement state.ValuesOf(kBConf, {}) instead of iterating through all combinations
+//TODO: implement state.ValuesOf(conf_, {}) instead of iterating through all combinations
 
 namespace kitchen {
 
 using namespace std;
 
+namespace {
+
+// probability of a fluent with odds start_odds after k looks that each
+// multiply its odds by ratio
+float EndProb(float start_odds, float ratio, int k) {
+  float odds = start_odds * pow(ratio, k);
+  return odds / (1.f + odds);
+}
+
+} // namespace
+
 // MoveOperator
 
 MoveOperator::MoveOperator(int name, float prob, float base_cost, bool log_cost) : Operator(name, prob, 0.f, base_cost, 0.f, log_cost) {}
 
 void MoveOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kMove = StringRegistry::Get()->GetInt("move");
-  const int kBConf = StringRegistry::Get()->GetInt("conf");
-  const int kBHeld = StringRegistry::Get()->GetInt("held");
-  const int kBFree = StringRegistry::Get()->GetInt("free");
-  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
-
   for (int start_loc = 0; start_loc < env.GetNumLocs(); ++start_loc) {
-    float startrlp  = state.GetProb(Fluent(kBConf, {}, start_loc));
+    float startrlp  = state.GetProb(Fluent(conf_, {}, start_loc));
     // in start loc
     if (startrlp > 0.f) {
       vector<int> end_locs;
@@ -49,44 +55,45 @@ void MoveOperator::ApplicableActions(const State &state, const Environment &env,
       // move right
       new_loc = start_loc + 1;
       if (new_loc < env.GetNumLocs()) {end_locs.push_back(new_loc);}
-      float hnp  = state.GetProb(Fluent(kBHeld, {}, -1));
+      float hnp  = state.GetProb(Fluent(held_, {}, -1));
       // move to end loc
       for (int end_loc : end_locs) {
-        float freep  = state.GetProb(Fluent(kBFree, {}, end_loc));
+        float freep  = state.GetProb(Fluent(free_, {}, end_loc));
         // robot moves if it's holding nothing or
         // if it's holding something and endloc is free
         float movep = startrlp * (hnp + (1.f - hnp) * freep) * prob_;
         if (movep > 0.f) {
-          float endrlp  = state.GetProb(Fluent(kBConf, {}, end_loc));
-
-          const vector<Fluent> preconditions{};
-          vector<Fluent> add_list{Fluent(kBConf, {}, start_loc, startrlp - movep),
-                                  Fluent(kBConf, {}, end_loc, endrlp + movep)};
-          vector<Fluent> delete_list{Fluent(kBConf, {}, start_loc, startrlp),
-                                     Fluent(kBConf, {}, end_loc, endrlp)};
-
-          float startfreep = state.GetProb(Fluent(kBFree, {}, start_loc));
-          float endfreep = state.GetProb(Fluent(kBFree, {}, end_loc));
-          delete_list.push_back(Fluent(kBFree, {}, start_loc, startfreep));
-          delete_list.push_back(Fluent(kBFree, {}, end_loc, endfreep));
+          float endrlp  = state.GetProb(Fluent(conf_, {}, end_loc));
+
+          vector<Fluent> preconditions{Fluent(held_, {}, -1, hnp)};
+          vector<Fluent> add_list{Fluent(conf_, {}, start_loc, startrlp - movep),
+                                  Fluent(conf_, {}, end_loc, endrlp + movep)};
+          vector<Fluent> delete_list{Fluent(conf_, {}, start_loc, startrlp),
+                                     Fluent(conf_, {}, end_loc, endrlp)};
+
+          float startfreep = state.GetProb(Fluent(free_, {}, start_loc));
+          float endfreep = state.GetProb(Fluent(free_, {}, end_loc));
+          delete_list.push_back(Fluent(free_, {}, start_loc, startfreep));
+          delete_list.push_back(Fluent(free_, {}, end_loc, endfreep));
           for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
-            float hp  = state.GetProb(Fluent(kBHeld, {}, obj));
-            float startolp  = state.GetProb(Fluent(kBObjLoc, {obj}, start_loc));
-            float endolp  = state.GetProb(Fluent(kBObjLoc, {obj}, end_loc));
+            float hp  = state.GetProb(Fluent(held_, {}, obj));
+            float startolp  = state.GetProb(Fluent(obj_loc_, {obj}, start_loc));
+            float endolp  = state.GetProb(Fluent(obj_loc_, {obj}, end_loc));
             float objmovep = startolp * hp * freep * prob_;
+            preconditions.push_back(Fluent(held_, {}, obj, hp));
             if (objmovep > 0.f) {
-              add_list.push_back(Fluent(kBObjLoc, {obj}, start_loc, startolp - objmovep));
-              add_list.push_back(Fluent(kBObjLoc, {obj}, end_loc, endolp + objmovep));
-              delete_list.push_back(Fluent(kBObjLoc, {obj}, start_loc, startolp));
-              delete_list.push_back(Fluent(kBObjLoc, {obj}, end_loc, endolp));
+              add_list.push_back(Fluent(obj_loc_, {obj}, start_loc, startolp - objmovep));
+              add_list.push_back(Fluent(obj_loc_, {obj}, end_loc, endolp + objmovep));
+              delete_list.push_back(Fluent(obj_loc_, {obj}, start_loc, startolp));
+              delete_list.push_back(Fluent(obj_loc_, {obj}, end_loc, endolp));
               startfreep += objmovep;
               endfreep -= objmovep;
             }
           }
-          add_list.push_back(Fluent(kBFree, {}, start_loc, startfreep));
-          add_list.push_back(Fluent(kBFree, {}, end_loc, endfreep));
+          add_list.push_back(Fluent(free_, {}, start_loc, startfreep));
+          add_list.push_back(Fluent(free_, {}, end_loc, endfreep));
 
-          actions->emplace_back(new Action(kMove, Cost(1.f), add_list, delete_list, {start_loc, end_loc}));
+          actions->emplace_back(new Action(name_, Cost(1.f), preconditions, add_list, delete_list, {start_loc, end_loc}));
         }
       }
     }
@@ -98,29 +105,25 @@ void MoveOperator::ApplicableActions(const State &state, const Environment &env,
 PickOperator::PickOperator(int name, float prob, float base_cost, bool log_cost) : Operator(name, prob, 0.f, base_cost, 0.f, log_cost) {}
 
 void PickOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kPick = StringRegistry::Get()->GetInt("pick");
-  const int kBConf = StringRegistry::Get()->GetInt("conf");
-  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
-  const int kBHeld = StringRegistry::Get()->GetInt("held");
-
-  float hnp  = state.GetProb(Fluent(kBHeld, {}, -1));
+  float hnp  = state.GetProb(Fluent(held_, {}, -1));
   if (hnp > 0.f) {
     for (int loc = 0; loc < env.GetNumLocs(); ++loc) {
-      float rlp  = state.GetProb(Fluent(kBConf, {}, loc));
+      float rlp  = state.GetProb(Fluent(conf_, {}, loc));
       if (rlp > 0.f) {
         for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
-          float olp  = state.GetProb(Fluent(kBObjLoc, {obj}, loc));
+          float olp  = state.GetProb(Fluent(obj_loc_, {obj}, loc));
           if (olp > 0.f) {
-            float hop  = state.GetProb(Fluent(kBHeld, {}, obj));
+            float hop  = state.GetProb(Fluent(held_, {}, obj));
             float pickp = rlp * olp * hnp * prob_;
 
-            vector<Fluent> preconditions{};
-            vector<Fluent> add_list{Fluent(kBHeld, {}, -1, hnp - pickp),
-                                    Fluent(kBHeld, {}, obj, hop + pickp)};
-            vector<Fluent> delete_list{Fluent(kBHeld, {}, -1, hnp),
-                                       Fluent(kBHeld, {}, obj, hop)};
+            vector<Fluent> preconditions{Fluent(conf_, {}, loc, rlp),
+                                         Fluent(obj_loc_, {obj}, loc, olp)};
+            vector<Fluent> add_list{Fluent(held_, {}, -1, hnp - pickp),
+                                    Fluent(held_, {}, obj, hop + pickp)};
+            vector<Fluent> delete_list{Fluent(held_, {}, -1, hnp),
+                                       Fluent(held_, {}, obj, hop)};
 
-            actions->emplace_back(new Action(kPick, Cost(1.f), add_list, delete_list, {obj, loc}));
+            actions->emplace_back(new Action(name_, Cost(1.f), preconditions, add_list, delete_list, {obj, loc}));
           }
         }
       }
@@ -133,28 +136,24 @@ void PickOperator::ApplicableActions(const State &state, const Environment &env,
 PlaceOperator::PlaceOperator(int name, float prob, float base_cost, bool log_cost) : Operator(name, prob, 0.f, base_cost, 0.f, log_cost) {}
 
 void PlaceOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kPlace = StringRegistry::Get()->GetInt("place");
-  const int kBConf = StringRegistry::Get()->GetInt("conf");
-  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
-  const int kBHeld = StringRegistry::Get()->GetInt("held");
-
   for (int loc = 0; loc < env.GetNumLocs(); ++loc) {
-    float rlp  = state.GetProb(Fluent(kBConf, {}, loc));
+    float rlp  = state.GetProb(Fluent(conf_, {}, loc));
     if (rlp > 0.f) {
       for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
-        float hop  = state.GetProb(Fluent(kBHeld, {}, obj));
-        float olp  = state.GetProb(Fluent(kBObjLoc, {obj}, loc));
+        float hop  = state.GetProb(Fluent(held_, {}, obj));
+        float olp  = state.GetProb(Fluent(obj_loc_, {obj}, loc));
         float placep = rlp * olp * hop * prob_;
         if (placep > 0.f) {
-          float hnp  = state.GetProb(Fluent(kBHeld, {}, -1));
+          float hnp  = state.GetProb(Fluent(held_, {}, -1));
 
-          vector<Fluent> preconditions{};
-          vector<Fluent> add_list{Fluent(kBHeld, {}, obj, hop - placep),
-                                  Fluent(kBHeld, {}, -1, hnp + placep)};
-          vector<Fluent> delete_list{Fluent(kBHeld, {}, obj, hop),
-                                     Fluent(kBHeld, {}, -1, hnp)};
+          vector<Fluent> preconditions{Fluent(conf_, {}, loc, rlp),
+                                       Fluent(obj_loc_, {obj}, loc, olp)};
+          vector<Fluent> add_list{Fluent(held_, {}, obj, hop - placep),
+                                  Fluent(held_, {}, -1, hnp + placep)};
+          vector<Fluent> delete_list{Fluent(held_, {}, obj, hop),
+                                     Fluent(held_, {}, -1, hnp)};
 
-          actions->emplace_back(new Action(kPlace, Cost(1.f), add_list, delete_list, {obj, loc}));
+          actions->emplace_back(new Action(name_, Cost(1.f), preconditions, add_list, delete_list, {obj, loc}));
         }
       }
     }
@@ -166,25 +165,21 @@ void PlaceOperator::ApplicableActions(const State &state, const Environment &env
 CookOperator::CookOperator(int name, float prob, float obs) : Operator(name, prob, obs) {}
 
 void CookOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kCook = StringRegistry::Get()->GetInt("cook");
-  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
-  const int kBHeld = StringRegistry::Get()->GetInt("held");
-  const int kBCooked = StringRegistry::Get()->GetInt("cooked");
-
-  float hnp  = state.GetProb(Fluent(kBHeld, {}, -1));
+  float hnp  = state.GetProb(Fluent(held_, {}, -1));
   if (hnp > 0.f) {
     for (int stove_loc : env.GetStoveLocs()) {
       for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
-        float olp  = state.GetProb(Fluent(kBObjLoc, {obj}, stove_loc));
+        float olp  = state.GetProb(Fluent(obj_loc_, {obj}, stove_loc));
         if (olp > 0.f) {
-          float startcp  = state.GetProb(Fluent(kBCooked, {}, obj));
+          float startcp  = state.GetProb(Fluent(cooked_, {}, obj));
           float endcp  = startcp + (1.f - startcp) * olp * hnp * prob_;
 
-          vector<Fluent> preconditions{};
-          vector<Fluent> add_list{Fluent(kBCooked, {}, obj, endcp)};
-          vector<Fluent> delete_list{Fluent(kBCooked, {}, obj, startcp)};
+          vector<Fluent> preconditions{Fluent(held_, {}, -1, hnp),
+                                       Fluent(obj_loc_, {obj}, stove_loc, olp)};
+          vector<Fluent> add_list{Fluent(cooked_, {}, obj, endcp)};
+          vector<Fluent> delete_list{Fluent(cooked_, {}, obj, startcp)};
 
-          actions->emplace_back(new Action(kCook, Cost(1.f), add_list, delete_list, {}));
+          actions->emplace_back(new Action(name_, Cost(1.f), preconditions, add_list, delete_list, {}));
         }
       }
     }
@@ -196,11 +191,8 @@ void CookOperator::ApplicableActions(const State &state, const Environment &env,
 LookRobotOperator::LookRobotOperator(int name, float prob, float base_cost, float cost_multiplier, bool log_cost) : Operator(name, prob, 0.f, base_cost, cost_multiplier, log_cost) {}
 
 void LookRobotOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kLookRobot = StringRegistry::Get()->GetInt("look_robot");
-  const int kBConf = StringRegistry::Get()->GetInt("conf");
-
   for (int loc = 0; loc < env.GetNumLocs(); ++loc) {
-    float start_p  = state.GetProb(Fluent(kBConf, {}, loc));
+    float start_p  = state.GetProb(Fluent(conf_, {}, loc));
     if (start_p > 0.f) {
       // P(obs = Robot)
       // = P(obs = Robot | loc = l) * P(loc = l) + 
@@ -210,18 +202,18 @@ void LookRobotOperator::ApplicableActions(const State &state, const Environment
       float fail_p = (1.f - prob_) / obs_p;
 
       vector<Fluent> preconditions{};
-      vector<Fluent> add_list{Fluent(kBConf, {}, loc, start_p * success_p)};
-      vector<Fluent> delete_list{Fluent(kBConf, {}, loc, start_p)};
+      vector<Fluent> add_list{Fluent(conf_, {}, loc, start_p * success_p)};
+      vector<Fluent> delete_list{Fluent(conf_, {}, loc, start_p)};
 
       for (int o_loc = 0; o_loc < env.GetNumLocs(); ++o_loc) {
         if (o_loc != loc) {
-          add_list.push_back(Fluent(kBConf, {}, o_loc, state.GetProb(Fluent(kBConf, {}, o_loc)) * fail_p));
-          delete_list.push_back(Fluent(kBConf, {}, o_loc, state.GetProb(Fluent(kBConf, {}, o_loc))));
+          add_list.push_back(Fluent(conf_, {}, o_loc, state.GetProb(Fluent(conf_, {}, o_loc)) * fail_p));
+          delete_list.push_back(Fluent(conf_, {}, o_loc, state.GetProb(Fluent(conf_, {}, o_loc))));
         }
       }
 
       if (obs_p > 0.f) {
-        actions->emplace_back(new Action(kLookRobot, Cost(obs_p), add_list, delete_list, {loc}));
+        actions->emplace_back(new Action(name_, Cost(obs_p), preconditions, add_list, delete_list, {loc}));
       }
     }
   }
@@ -232,11 +224,8 @@ void LookRobotOperator::ApplicableActions(const State &state, const Environment
 LookHandOperator::LookHandOperator(int name, float prob, float base_cost, float cost_multiplier, bool log_cost) : Operator(name, prob, 0.f, base_cost, cost_multiplier, log_cost) {}
 
 void LookHandOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kLookHand = StringRegistry::Get()->GetInt("look_hand");
-  const int kBHeld = StringRegistry::Get()->GetInt("held");
-
   for (int obj = -1; obj < env.GetNumObjs(); ++obj) {
-    float start_p  = state.GetProb(Fluent(kBHeld, {}, obj));
+    float start_p  = state.GetProb(Fluent(held_, {}, obj));
     if (start_p > 0.f) {
       // P(obs = o)
       // = P(obs = o | holding = o) * P(holding = o) + 
@@ -246,18 +235,18 @@ void LookHandOperator::ApplicableActions(const State &state, const Environment &
       float fail_p = (1.f - prob_) / obs_p;
 
       vector<Fluent> preconditions{};
-      vector<Fluent> add_list{Fluent(kBHeld, {}, obj, start_p * success_p)};
-      vector<Fluent> delete_list{Fluent(kBHeld, {}, obj, start_p)};
+      vector<Fluent> add_list{Fluent(held_, {}, obj, start_p * success_p)};
+      vector<Fluent> delete_list{Fluent(held_, {}, obj, start_p)};
 
       for (int o_obj = -1; o_obj < env.GetNumObjs(); ++o_obj) {
         if (o_obj != obj) {
-          add_list.push_back(Fluent(kBHeld, {}, o_obj, state.GetProb(Fluent(kBHeld, {}, o_obj)) * fail_p));
-          delete_list.push_back(Fluent(kBHeld, {}, o_obj, state.GetProb(Fluent(kBHeld, {}, o_obj))));
+          add_list.push_back(Fluent(held_, {}, o_obj, state.GetProb(Fluent(held_, {}, o_obj)) * fail_p));
+          delete_list.push_back(Fluent(held_, {}, o_obj, state.GetProb(Fluent(held_, {}, o_obj))));
         }
       }
 
       if (obs_p > 0.f) {
-        actions->emplace_back(new Action(kLookHand, Cost(obs_p), add_list, delete_list, {obj}));
+        actions->emplace_back(new Action(name_, Cost(obs_p), preconditions, add_list, delete_list, {obj}));
       }
     }
   }
@@ -268,14 +257,10 @@ void LookHandOperator::ApplicableActions(const State &state, const Environment &
 LookObjOperator::LookObjOperator(int name, float prob, float base_cost, float cost_multiplier, bool log_cost) : Operator(name, prob, 0.f, base_cost, cost_multiplier, log_cost) {}
 
 void LookObjOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kLookObj = StringRegistry::Get()->GetInt("look_obj");
-  const int kBObjLoc = StringRegistry::Get()->GetInt("obj_loc");
-  const int kBFree = StringRegistry::Get()->GetInt("free");
-
   // look for obj in location
   for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
     for (int loc = 0; loc < env.GetNumLocs(); ++loc) {
-      float start_p  = state.GetProb(Fluent(kBObjLoc, {obj}, loc));
+      float start_p  = state.GetProb(Fluent(obj_loc_, {obj}, loc));
       //if (start_p > (1.f / env.GetNumObjs())) {
       //if (start_p > 0.f) {
       if (start_p > 0.1f) {
@@ -288,26 +273,26 @@ void LookObjOperator::ApplicableActions(const State &state, const Environment &e
 
 
         vector<Fluent> preconditions{};
-        vector<Fluent> add_list{Fluent(kBObjLoc, {obj}, loc, start_p * success_p)};
-        vector<Fluent> delete_list{Fluent(kBObjLoc, {obj}, loc, start_p)};
+        vector<Fluent> add_list{Fluent(obj_loc_, {obj}, loc, start_p * success_p)};
+        vector<Fluent> delete_list{Fluent(obj_loc_, {obj}, loc, start_p)};
 
         // adjust probabilities of other objects
         for (int o_obj = 0; o_obj < env.GetNumObjs(); ++o_obj) {
           if (o_obj != obj) {
-            add_list.push_back(Fluent(kBObjLoc, {o_obj}, loc, state.GetProb(Fluent(kBObjLoc, {o_obj}, loc)) * fail_p));
-            delete_list.push_back(Fluent(kBObjLoc, {o_obj}, loc, state.GetProb(Fluent(kBObjLoc, {o_obj}, loc))));
+            add_list.push_back(Fluent(obj_loc_, {o_obj}, loc, state.GetProb(Fluent(obj_loc_, {o_obj}, loc)) * fail_p));
+            delete_list.push_back(Fluent(obj_loc_, {o_obj}, loc, state.GetProb(Fluent(obj_loc_, {o_obj}, loc))));
           }
         }
 
         if (obs_p > 0.f) {
-          actions->emplace_back(new Action(kLookObj, Cost(obs_p), add_list, delete_list, {obj, loc}));
+          actions->emplace_back(new Action(name_, Cost(obs_p), preconditions, add_list, delete_list, {obj, loc}));
         }
       }
     }
   }
   // look for nothing in location
   for (int loc = 0; loc < env.GetNumLocs(); ++loc) {
-    float start_p  = state.GetProb(Fluent(kBFree, {}, loc));
+    float start_p  = state.GetProb(Fluent(free_, {}, loc));
     //if (start_p > 0.1f) {
     //if (start_p > (1.f / env.GetNumObjs())) {
     if (start_p > 0.f) {
@@ -319,18 +304,105 @@ void LookObjOperator::ApplicableActions(const State &state, const Environment &e
       float fail_p = (1.f - prob_) / obs_p;
 
       vector<Fluent> preconditions{};
-      vector<Fluent> add_list{Fluent(kBFree, {}, loc, start_p * success_p)};
-      vector<Fluent> delete_list{Fluent(kBFree, {}, loc, start_p)};
+      vector<Fluent> add_list{Fluent(free_, {}, loc, start_p * success_p)};
+      vector<Fluent> delete_list{Fluent(free_, {}, loc, start_p)};
 
       // adjust probabilities of objects
       for (int obj = 0; obj < env.GetNumObjs(); ++obj) {
-        add_list.push_back(Fluent(kBObjLoc, {obj}, loc, state.GetProb(Fluent(kBObjLoc, {obj}, loc)) * fail_p));
-        delete_list.push_back(Fluent(kBObjLoc, {obj}, loc, state.GetProb(Fluent(kBObjLoc, {obj}, loc))));
+        add_list.push_back(Fluent(obj_loc_, {obj}, loc, state.GetProb(Fluent(obj_loc_, {obj}, loc)) * fail_p));
+        delete_list.push_back(Fluent(obj_loc_, {obj}, loc, state.GetProb(Fluent(obj_loc_, {obj}, loc))));
       }
 
       if (obs_p > 0.f) {
-        actions->emplace_back(new Action(kLookObj, Cost(obs_p), add_list, delete_list, {-1, loc}));
+        actions->emplace_back(new Action(name_, Cost(obs_p), preconditions, add_list, delete_list, {-1, loc}));
+      }
+    }
+  }
+}
+
+// LookObjMacroOperator
+
+LookObjMacroOperator::LookObjMacroOperator(int name, float prob, float base_cost, float cost_multiplier, bool log_cost, const vector<float> &thresholds) : LookObjOperator(name, prob, base_cost, cost_multiplier, log_cost), thresholds_(thresholds) {
+  sort(thresholds_.begin(), thresholds_.end());
+  thresholds_.erase(unique(thresholds_.begin(), thresholds_.end()), thresholds_.end());
+}
+
+void LookObjMacroOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
+  // more looks than this are not worth a macro
+  const int kMaxLooks = 100;
+
+  // every look multiplies the odds of the looked fluent by ratio
+  if (prob_ <= 0.5f || prob_ >= 1.f) {
+    return;
+  }
+  float ratio = prob_ / (1.f - prob_);
+
+  // a macro for every applicable single look, whose info is (obj, loc) with
+  // obj -1 for a look for nothing
+  vector<unique_ptr<Action>> looks;
+  LookObjOperator::ApplicableActions(state, env, &looks);
+  for (const unique_ptr<Action> &look : looks) {
+    const int obj = look->GetInfo()[0];
+    const int loc = look->GetInfo()[1];
+    // the looked fluent first, then the ones every look makes less likely
+    vector<Fluent> fluents;
+    if (obj >= 0) {
+      fluents.push_back(Fluent(obj_loc_, {obj}, loc, state.GetProb(Fluent(obj_loc_, {obj}, loc))));
+    } else {
+      fluents.push_back(Fluent(free_, {}, loc, state.GetProb(Fluent(free_, {}, loc))));
+    }
+    for (int o_obj = 0; o_obj < env.GetNumObjs(); ++o_obj) {
+      if (o_obj != obj) {
+        fluents.push_back(Fluent(obj_loc_, {o_obj}, loc, state.GetProb(Fluent(obj_loc_, {o_obj}, loc))));
+      }
+    }
+    float start_p = fluents[0].GetProb();
+    if (start_p <= 0.f || start_p >= 1.f) {
+      continue;
+    }
+    float start_odds = start_p / (1.f - start_p);
+
+    int prev_k = 1;
+    for (float threshold : thresholds_) {
+      if (threshold <= start_p || threshold >= 1.f) {
+        continue;
+      }
+      // smallest k with start_odds * ratio^k >= threshold odds, from the
+      // exact log ratio and then checked against the end_p the macro adds,
+      // so that rounding neither leaves it below threshold nor adds a look
+      int k = max(1, static_cast<int>(ceil(log((static_cast<double>(threshold) / (1.0 - threshold)) / start_odds) / log(static_cast<double>(ratio)))));
+      while (k > 1 && EndProb(start_odds, ratio, k - 1) >= threshold) {
+        --k;
+      }
+      while (k <= kMaxLooks && EndProb(start_odds, ratio, k) < threshold) {
+        ++k;
+      }
+      if (k <= prev_k || k > kMaxLooks) {
+        continue;
+      }
+      prev_k = k;
+
+      float end_p = EndProb(start_odds, ratio, k);
+      // every look multiplies the other fluents by (1 - prob) / P(obs), and
+      // the product of the k P(obs) is start_p * prob^k / end_p
+      float fail_p = (end_p / start_p) / pow(ratio, k);
+      float cost = 0.f;
+      if (log_cost_) {
+        cost = k * base_cost_ + cost_multiplier_ * log2(end_p / (start_p * pow(prob_, k)));
+      } else {
+        float p = start_p;
+        for (int i = 0; i < k; ++i) {
+          float obs_p = prob_ * p + (1.f - prob_) * (1.f - p);
+          cost += Cost(obs_p);
+          p = p * prob_ / obs_p;
+        }
+      }
+
+      vector<Fluent> add_list{Fluent(fluents[0].GetPredicate(), fluents[0].GetArgs(), fluents[0].GetValue(), end_p)};
+      for (int i = 1; i < fluents.size(); ++i) {
+        add_list.push_back(Fluent(fluents[i].GetPredicate(), fluents[i].GetArgs(), fluents[i].GetValue(), fluents[i].GetProb() * fail_p));
       }
+      actions->emplace_back(new Action(name_, cost, {}, add_list, fluents, {obj, loc, k}));
     }
   }
 }
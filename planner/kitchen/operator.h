@@ -19,6 +19,7 @@
 
 #include "kitchen/environment.h"
 #include <operator.h>
+#include "string_registry.h"
 #include "support.h"
 
 namespace kitchen {
@@ -37,6 +38,14 @@ class Operator : public ::Operator {
   }
 
   virtual void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const = 0;
+
+ protected:
+  // registry ids of the predicates, looked up once when the operator is built
+  const int conf_ = StringRegistry::Get()->GetInt("conf");
+  const int held_ = StringRegistry::Get()->GetInt("held");
+  const int free_ = StringRegistry::Get()->GetInt("free");
+  const int obj_loc_ = StringRegistry::Get()->GetInt("obj_loc");
+  const int cooked_ = StringRegistry::Get()->GetInt("cooked");
 };
 
 class MoveOperator : public Operator {
@@ -88,6 +97,22 @@ class LookObjOperator : public Operator {
   void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const override;
 };
 
+// look_obj repeated k >= 2 times in a row, for the smallest k that takes the
+// looked fluent to each of thresholds, at the summed cost of the looks
+class LookObjMacroOperator : public LookObjOperator {
+ public:
+  LookObjMacroOperator(int name, float prob, float base_cost, float cost_multiplier, bool log_cost, const std::vector<float> &thresholds);
+
+  bool IsMacro() const override {
+    return true;
+  }
+
+  void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const override;
+
+ private:
+  std::vector<float> thresholds_;
+};
+
 } // namespace kitchen
 
 #endif  // KITCHEN_OPERATOR_H
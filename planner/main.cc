@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <iostream>
 
 #include <gflags/gflags.h>
@@ -21,6 +22,8 @@
 #include "kitchen/context.h"
 #include "rocksample/context.h"
 #include "gripper/context.h"
+#include "realtime_search.h"
+#include "search_options.h"
 #include "string_registry.h"
 
 DEFINE_string(problem, "", "One of the following problem kinds: kitchen, rocksample, gripper");
@@ -29,22 +32,64 @@ DEFINE_bool(verbose, false, "Make the search verbose");
 DEFINE_bool(file, false, "Specify domain using an input file");
 DEFINE_double(weight, 0.f, "Specify weight (0.0 = greediest)");
 DEFINE_double(epsilon, 0.f, "Specify epsilon");
+DEFINE_bool(reopen, false, "Reopen expanded states when a cheaper path to them is found");
+DEFINE_double(time_limit, 0.f, "Stop searching after this many seconds and print the plan to the most promising expanded node (0 = no limit)");
+DEFINE_bool(anytime, false, "Keep improving the plan while raising the weight up to 0.5, printing every cheaper plan");
+DEFINE_double(anytime_step, 0.05f, "Weight added after each round of the anytime search");
+DEFINE_bool(greedy, false, "Greedy best-first search on the heuristic cost alone");
+DEFINE_bool(preferred, false, "Greedy search: also queue children reached by helpful actions in a preferred open list, using the relaxed plan cost as the heuristic (evaluated as with --deferred)");
+DEFINE_int32(preferred_boost, 1000, "Greedy search: extra turns of the preferred open list whenever the heuristic cost improves");
+DEFINE_bool(deferred, false, "Greedy search: evaluate the heuristic when a node is expanded rather than generated");
+DEFINE_bool(hill_climbing, false, "Enforced hill-climbing, falling back to the complete search if it gets stuck");
+DEFINE_bool(ida, false, "Iterative deepening on the weighted cost, keeping only the current path (needs a positive weight)");
+DEFINE_int32(ida_table_size, 0, "IDA*: remember up to this many states per iteration to skip transpositions (0 = none)");
+DEFINE_int32(beam_width, 0, "Beam search keeping this many nodes per depth (0 = no beam search)");
+DEFINE_int32(beam_depth, 1000, "Beam search: give up after this many layers without a goal");
+DEFINE_int32(beam_restarts, 0, "Beam search: search again this many times, doubling the width, after failing");
+DEFINE_string(width_search, "", "Width-based search: iw (IW(1), IW(2), ... up to --width) or bfws (best-first width search)");
+DEFINE_int32(width, 2, "Width search: largest tuples of atoms whose novelty is measured, 1 or 2");
+DEFINE_bool(width_heuristic, false, "BFWS: break ties on the heuristic cost, otherwise no heuristic is evaluated");
+DEFINE_int32(lrta_lookahead, 0, "Real-time search (LRTA*) expanding this many nodes per step (0 = no real-time search)");
+DEFINE_int32(lrta_steps, 1, "Real-time search: steps to take, 1 returns just the next action (0 = until a goal is reached)");
+DEFINE_string(lrta_table, "", "Real-time search: load the learned heuristic costs from this file and save them back to it");
+DEFINE_bool(serve, false, "Keep running and solve the problems read one after another from stdin (needs --file), printing 'end of request' after each; the real-time search keeps its learned costs in memory and saves them to --lrta_table at exit");
+DEFINE_int32(max_nodes, 0, "Forget the least promising nodes when more than this many are kept (0 = no bound)");
+DEFINE_int32(max_memory_mb, 0, "Forget the least promising nodes when they take more than this many MB (0 = no bound)");
+DEFINE_int32(threads, 1, "Number of threads for hash distributed search");
+DEFINE_int32(eval_threads, 1, "Number of threads evaluating the heuristic for the children of an expansion");
+DEFINE_int32(batch_size, 1, "Number of best nodes expanded together (in parallel with --eval_threads)");
+DEFINE_string(portfolio, "", "Run these heuristic[:weight[:epsilon]] configurations side by side and keep the first plan, e.g. 'default:0.35,zero:0.5,default:0'");
+DEFINE_string(open_list, "heap", "Open list for the search: heap or bucket");
+DEFINE_double(bucket_width, 0.01f, "Weighted cost resolution of the bucket open list");
+DEFINE_bool(relevance, false, "Prune actions and fluents that cannot contribute to the goal before searching");
+DEFINE_int32(relevance_max_states, 1000, "Keep every action and fluent if the relevance analysis reaches more than this many states");
+DEFINE_bool(partial_order, false, "Apply actions that commute (e.g. looks at different locations) in one order only");
+DEFINE_bool(dominance, false, "Drop states that are no more likely to satisfy the goal than a state reached at no higher cost");
+DEFINE_bool(symmetry, false, "Treat states that differ only by swapping interchangeable objects as one (default search and portfolio only, the other modes ignore it)");
+DEFINE_bool(macro_looks, false, "Kitchen: add look actions repeated until the belief reaches a goal probability, at the summed cost of the looks");
+DEFINE_string(pdb, "", "Use the pattern database tables in this file as the heuristic");
+DEFINE_string(build_pdb, "", "Build pattern database tables for the problem and write them to this file");
+DEFINE_string(pdb_patterns, "", "Patterns for --build_pdb, e.g. 'conf,held;obj_loc' (default: all goal predicates)");
+DEFINE_int32(pdb_buckets, 10, "Probability buckets per fluent in pattern database abstract states");
+DEFINE_int32(pdb_max_states, 1000000, "Maximum number of abstract states per pattern for --build_pdb");
 
 using namespace std;
 
-int main(int argc, char **argv) {
-  google::ParseCommandLineFlags(&argc, &argv, true);
+namespace {
 
-  StringRegistry::Init();
+int Solve(SearchOptions options) {
+  if (FLAGS_time_limit > 0.f) {
+    options.deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(FLAGS_time_limit));
+  }
 
   int result = 1; // Default to error.
 
   if (FLAGS_problem == "kitchen") {
-    result = kitchen::Kitchen(FLAGS_verbose, FLAGS_file, static_cast<float>(FLAGS_weight), static_cast<float>(FLAGS_epsilon));
+    result = kitchen::Kitchen(FLAGS_file, options);
   } else if (FLAGS_problem == "rocksample") {
-    result = rocksample::RockSample(FLAGS_verbose, FLAGS_file, static_cast<float>(FLAGS_discount));
+    result = rocksample::RockSample(FLAGS_file, static_cast<float>(FLAGS_discount), options);
   } else if (FLAGS_problem == "gripper") {
-    result = gripper::Gripper(FLAGS_verbose, FLAGS_file, static_cast<float>(FLAGS_discount));
+    result = gripper::Gripper(FLAGS_file, static_cast<float>(FLAGS_discount), options);
   } else if (FLAGS_problem.empty()) {
     cerr << "Need to specify the 'problem' parameter!" << endl;
   } else {
@@ -53,3 +98,76 @@ int main(int argc, char **argv) {
 
   return result;
 }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  StringRegistry::Init();
+
+  SearchOptions options;
+  options.verbose = FLAGS_verbose;
+  options.weight = static_cast<float>(FLAGS_weight);
+  options.epsilon = static_cast<float>(FLAGS_epsilon);
+  options.relevance = FLAGS_relevance;
+  options.relevance_max_states = FLAGS_relevance_max_states;
+  options.partial_order = FLAGS_partial_order;
+  options.dominance = FLAGS_dominance;
+  options.symmetry_reduction = FLAGS_symmetry;
+  options.macro_looks = FLAGS_macro_looks;
+  options.reopen = FLAGS_reopen;
+  options.anytime = FLAGS_anytime;
+  options.anytime_step = static_cast<float>(FLAGS_anytime_step);
+  options.greedy = FLAGS_greedy;
+  options.preferred = FLAGS_preferred;
+  options.preferred_boost = FLAGS_preferred_boost;
+  options.deferred = FLAGS_deferred;
+  options.hill_climbing = FLAGS_hill_climbing;
+  options.ida = FLAGS_ida;
+  options.ida_table_size = FLAGS_ida_table_size;
+  options.beam_width = FLAGS_beam_width;
+  options.beam_depth = FLAGS_beam_depth;
+  options.beam_restarts = FLAGS_beam_restarts;
+  options.width_search = FLAGS_width_search;
+  options.width = FLAGS_width;
+  options.width_heuristic = FLAGS_width_heuristic;
+  options.lrta_lookahead = FLAGS_lrta_lookahead;
+  options.lrta_steps = FLAGS_lrta_steps;
+  options.lrta_table = FLAGS_lrta_table;
+  options.max_nodes = FLAGS_max_nodes;
+  options.max_memory_mb = FLAGS_max_memory_mb;
+  options.threads = FLAGS_threads;
+  options.eval_threads = FLAGS_eval_threads;
+  options.batch_size = FLAGS_batch_size;
+  options.portfolio = FLAGS_portfolio;
+  options.open_list = FLAGS_open_list;
+  options.bucket_width = static_cast<float>(FLAGS_bucket_width);
+  options.pdb_file = FLAGS_pdb;
+  options.pdb_build_file = FLAGS_build_pdb;
+  options.pdb_patterns = FLAGS_pdb_patterns;
+  options.pdb_buckets = FLAGS_pdb_buckets;
+  options.pdb_max_states = FLAGS_pdb_max_states;
+
+  if (!FLAGS_serve) {
+    return Solve(options);
+  }
+  if (!FLAGS_file) {
+    cerr << "--serve reads the problems from stdin and needs --file" << endl;
+    return 1;
+  }
+
+  // every step of the caller is one problem, so per-step latency stays that
+  // of the lookahead instead of growing with a table read from disk
+  LearnedTable table;
+  options.learned_table = &table;
+  int result = 1;
+  while ((cin >> ws).peek() != EOF) {
+    result = Solve(options);
+    cout << "end of request" << endl;
+  }
+  if (!FLAGS_lrta_table.empty() && table.Size() > 0 && !table.Save(FLAGS_lrta_table)) {
+    return 1;
+  }
+  return result;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "open_list.h"
+
+using namespace std;
+
+namespace {
+
+// keys at or past the last bucket go into the overflow heap
+const int kMaxBuckets = 1 << 20;
+
+} // namespace
+
+unique_ptr<OpenList> CreateOpenList(const SearchOptions &options, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env) {
+  if (options.epsilon > 0.f) {
+    return unique_ptr<OpenList>(new FocalList(options.epsilon, goal_set, operators, env));
+  } else if (options.open_list == "heap") {
+    return unique_ptr<OpenList>(new HeapOpenList());
+  } else if (options.open_list == "bucket" && options.bucket_width > 0.f) {
+    return unique_ptr<OpenList>(new BucketOpenList(options.bucket_width));
+  }
+  return nullptr;
+}
+
+// HeapOpenList
+
+bool HeapOpenList::empty() const {
+  return heap_.empty();
+}
+
+void HeapOpenList::push(const SearchNode *node) {
+  heap_.push(Entry(node->GetWeightedCost(), node));
+}
+
+const SearchNode* HeapOpenList::pop() {
+  const SearchNode *node = heap_.top().second;
+  heap_.pop();
+  return node;
+}
+
+void HeapOpenList::Release(vector<const SearchNode*> *nodes) {
+  while (!heap_.empty()) {
+    nodes->push_back(pop());
+  }
+}
+
+// BucketOpenList
+
+BucketOpenList::BucketOpenList(float width) : width_(width), non_empty_(kMaxBuckets / 64), non_empty_words_(kMaxBuckets / 64 / 64), min_bucket_(kMaxBuckets), num_bucketed_(0) {}
+
+bool BucketOpenList::empty() const {
+  return num_bucketed_ == 0 && overflow_.empty();
+}
+
+void BucketOpenList::push(const SearchNode *node) {
+  const float key = node->GetWeightedCost();
+  // written so that infinite and nan keys go into the overflow heap
+  if (!(key < kMaxBuckets * width_)) {
+    overflow_.push(make_pair(key == key ? key : numeric_limits<float>::infinity(), node));
+    return;
+  }
+  const int bucket = max(0, static_cast<int>(key / width_));
+  if (bucket >= buckets_.size()) {
+    buckets_.resize(bucket + 1);
+  }
+  if (buckets_[bucket].empty()) {
+    non_empty_[bucket / 64] |= uint64_t(1) << (bucket % 64);
+    non_empty_words_[bucket / 64 / 64] |= uint64_t(1) << (bucket / 64 % 64);
+  }
+  buckets_[bucket].push_back(node);
+  min_bucket_ = min(min_bucket_, bucket);
+  ++num_bucketed_;
+}
+
+const SearchNode* BucketOpenList::pop() {
+  if (num_bucketed_ == 0) {
+    const SearchNode *node = overflow_.top().second;
+    overflow_.pop();
+    return node;
+  }
+  min_bucket_ = NextBucket(min_bucket_);
+  vector<const SearchNode*> &bucket = buckets_[min_bucket_];
+  const SearchNode *node = bucket.back();
+  bucket.pop_back();
+  if (bucket.empty()) {
+    non_empty_[min_bucket_ / 64] &= ~(uint64_t(1) << (min_bucket_ % 64));
+    if (non_empty_[min_bucket_ / 64] == 0) {
+      non_empty_words_[min_bucket_ / 64 / 64] &= ~(uint64_t(1) << (min_bucket_ / 64 % 64));
+    }
+  }
+  --num_bucketed_;
+  return node;
+}
+
+void BucketOpenList::Release(vector<const SearchNode*> *nodes) {
+  for (vector<const SearchNode*> &bucket : buckets_) {
+    nodes->insert(nodes->end(), bucket.begin(), bucket.end());
+    bucket.clear();
+  }
+  fill(non_empty_.begin(), non_empty_.end(), 0);
+  fill(non_empty_words_.begin(), non_empty_words_.end(), 0);
+  min_bucket_ = kMaxBuckets;
+  num_bucketed_ = 0;
+  while (!overflow_.empty()) {
+    nodes->push_back(overflow_.top().second);
+    overflow_.pop();
+  }
+}
+
+int BucketOpenList::NextBucket(int bucket) const {
+  // rest of the word holding bucket
+  int word = bucket / 64;
+  uint64_t bits = non_empty_[word] & (~uint64_t(0) << (bucket % 64));
+  if (bits != 0) {
+    return word * 64 + __builtin_ctzll(bits);
+  }
+  // first word after it with a non-empty bucket
+  ++word;
+  int summary = word / 64;
+  uint64_t words = non_empty_words_[summary] & (~uint64_t(0) << (word % 64));
+  while (words == 0) {
+    words = non_empty_words_[++summary];
+  }
+  word = summary * 64 + __builtin_ctzll(words);
+  return word * 64 + __builtin_ctzll(non_empty_[word]);
+}
+
+// FocalList
+
+FocalList::FocalList(float epsilon, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env) : epsilon_(epsilon), goal_set_(goal_set), operators_(operators), env_(env), bound_(-numeric_limits<float>::infinity()) {}
+
+bool FocalList::empty() const {
+  return open_.empty();
+}
+
+void FocalList::push(const SearchNode *node) {
+  open_.insert(OpenEntry(node->GetWeightedCost(), node->GetCount(), node));
+  if (node->GetWeightedCost() <= bound_) {
+    PushFocal(node);
+  }
+}
+
+const SearchNode* FocalList::pop() {
+  UpdateBound();
+  const SearchNode *node = get<3>(*focal_.begin());
+  focal_.erase(focal_.begin());
+  open_.erase(OpenEntry(node->GetWeightedCost(), node->GetCount(), node));
+  return node;
+}
+
+void FocalList::Release(vector<const SearchNode*> *nodes) {
+  for (const OpenEntry &entry : open_) {
+    nodes->push_back(get<2>(entry));
+  }
+  open_.clear();
+  focal_.clear();
+  bound_ = -numeric_limits<float>::infinity();
+}
+
+void FocalList::PushFocal(const SearchNode *node) {
+  focal_.insert(FocalEntry(node->GetHMax(goal_set_, operators_, env_), node->GetWeightedCost(), node->GetCount(), node));
+}
+
+void FocalList::UpdateBound() {
+  float bound = get<0>(*open_.begin()) + epsilon_;
+  if (bound < bound_) {
+    // the weighted cost is not monotone, a cheaper node can lower the bound;
+    // nodes past the new bound leave focal
+    set<OpenEntry>::const_iterator iter = open_.lower_bound(OpenEntry(bound, numeric_limits<int>::max(), nullptr));
+    for (; iter != open_.end() && get<0>(*iter) <= bound_; ++iter) {
+      const SearchNode *node = get<2>(*iter);
+      focal_.erase(FocalEntry(node->GetHMax(goal_set_, operators_, env_), node->GetWeightedCost(), node->GetCount(), node));
+    }
+  } else if (bound > bound_) {
+    // open nodes within the old bound are already in focal
+    set<OpenEntry>::const_iterator iter = open_.lower_bound(OpenEntry(bound_, numeric_limits<int>::max(), nullptr));
+    for (; iter != open_.end() && get<0>(*iter) <= bound; ++iter) {
+      PushFocal(get<2>(*iter));
+    }
+  }
+  bound_ = bound;
+}
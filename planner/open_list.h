@@ -0,0 +1,148 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPEN_LIST_H
+#define OPEN_LIST_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "search_options.h"
+#include "uc_search.h"
+
+// Agenda of search nodes waiting to be expanded. Does not own the nodes.
+class OpenList {
+ public:
+  virtual ~OpenList() {}
+
+  virtual bool empty() const = 0;
+
+  virtual void push(const SearchNode *node) = 0;
+
+  virtual const SearchNode* pop() = 0;
+
+  // moves every queued node into nodes, leaving the list empty
+  virtual void Release(std::vector<const SearchNode*> *nodes) = 0;
+};
+
+// Returns the open list selected by options (the focal list whenever
+// options.epsilon > 0), or nullptr if options.open_list is unknown or its
+// settings are invalid.
+std::unique_ptr<OpenList> CreateOpenList(const SearchOptions &options, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env);
+
+// Binary heap on weighted cost. The key is computed once on push and stored
+// next to the node, so comparisons do not touch the nodes.
+class HeapOpenList : public OpenList {
+ public:
+  bool empty() const override;
+
+  void push(const SearchNode *node) override;
+
+  const SearchNode* pop() override;
+
+  void Release(std::vector<const SearchNode*> *nodes) override;
+
+ private:
+  // (weighted cost, node)
+  typedef std::pair<float, const SearchNode*> Entry;
+
+  // min priority queue
+  struct CompareEntry {
+    bool operator()(const Entry &lhs, const Entry &rhs) const {
+      return lhs.first > rhs.first;
+    }
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, CompareEntry> heap_;
+};
+
+// Bucket queue on weighted cost quantized to multiples of width. Push is
+// constant time and pop finds the lowest non-empty bucket through a two level
+// bitmap of the non-empty buckets. Nodes in the same bucket come out last in,
+// first out. Keys past the last bucket (including infinity) go into a binary
+// heap that is only popped once every bucket is empty.
+class BucketOpenList : public OpenList {
+ public:
+  BucketOpenList(float width);
+
+  bool empty() const override;
+
+  void push(const SearchNode *node) override;
+
+  const SearchNode* pop() override;
+
+  void Release(std::vector<const SearchNode*> *nodes) override;
+
+ private:
+  // first non-empty bucket at or after bucket
+  int NextBucket(int bucket) const;
+
+  const float width_;
+  std::vector<std::vector<const SearchNode*>> buckets_;
+  std::vector<uint64_t> non_empty_; // bit per bucket
+  std::vector<uint64_t> non_empty_words_; // bit per word of non_empty_
+  int min_bucket_; // no bucket before it is non-empty
+  int num_bucketed_; // nodes in buckets_
+  // (weighted cost, node) of the keys past the last bucket, min heap
+  std::priority_queue<std::pair<float, const SearchNode*>, std::vector<std::pair<float, const SearchNode*>>, std::greater<std::pair<float, const SearchNode*>>> overflow_;
+};
+
+// Agenda for the epsilon mode (focal search). Nodes are ordered by weighted
+// cost, and every node within epsilon of the cheapest one is also kept in a
+// focal list ordered by its cached HMax cost to goal. pop returns the head of
+// the focal list. The bound follows the cheapest open node in both
+// directions, since the weighted cost is not monotone: when it drops, the
+// nodes past it leave the focal list. HMax is computed at most once per node.
+class FocalList : public OpenList {
+ public:
+  FocalList(float epsilon, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env);
+
+  bool empty() const override;
+
+  void push(const SearchNode *node) override;
+
+  const SearchNode* pop() override;
+
+  void Release(std::vector<const SearchNode*> *nodes) override;
+
+ private:
+  void PushFocal(const SearchNode *node);
+
+  // moves open nodes that are now within epsilon of the cheapest into focal,
+  // and the ones that no longer are out of it
+  void UpdateBound();
+
+  // (weighted cost, count, node)
+  typedef std::tuple<float, int, const SearchNode*> OpenEntry;
+  // (HMax, weighted cost, count, node)
+  typedef std::tuple<float, float, int, const SearchNode*> FocalEntry;
+
+  const float epsilon_;
+  const std::vector<const State*> &goal_set_;
+  const std::vector<const Operator*> &operators_;
+  const Environment &env_;
+  float bound_;
+  std::set<OpenEntry> open_;
+  std::set<FocalEntry> focal_;
+};
+
+#endif  // OPEN_LIST_H
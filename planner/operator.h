@@ -55,6 +55,12 @@ class Operator {
 
   virtual void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const = 0;
 
+  // macro operators only chain actions of other operators, so relaxations
+  // leave them out
+  virtual bool IsMacro() const {
+    return false;
+  }
+
  protected:
   float Cost(float p) const {
     assert (p > 0.f);
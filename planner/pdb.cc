@@ -0,0 +1,475 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "environment.h"
+#include "pdb.h"
+#include "string_registry.h"
+
+using namespace std;
+
+// File layout: a PDBHeader, num_tables PDBTableHeaders, then for every table
+// num_entries sorted uint64_t keys followed by num_entries float costs. Dead
+// ends (abstract states that cannot reach the goal) have infinite costs.
+
+namespace {
+
+const char kMagic[8] = {'S', 'A', 'S', 'Y', 'P', 'D', 'B', '\0'};
+const uint32_t kVersion = 2;
+
+struct PDBHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_tables;
+  uint64_t goal_key;
+  uint64_t environment_key; // see EnvironmentKey
+  uint32_t buckets;
+  uint32_t padding;
+};
+
+struct PDBTableHeader {
+  char pattern[64]; // ','-separated predicate names
+  uint64_t offset; // from the start of the file, 8-byte aligned
+  uint64_t num_entries;
+};
+
+// FNV-1a, used instead of std::hash so that keys are the same in every build
+const uint64_t kFnvOffset = 14695981039346656037ULL;
+const uint64_t kFnvPrime = 1099511628211ULL;
+
+void FnvCombine(uint64_t v, uint64_t *seed) {
+  for (int i = 0; i < 8; ++i) {
+    *seed ^= (v >> (i * 8)) & 0xff;
+    *seed *= kFnvPrime;
+  }
+}
+
+// hash of one fluent, with the predicate identified by tag
+uint64_t AtomKey(uint64_t tag, const Fluent &f, int bucket) {
+  uint64_t key = kFnvOffset;
+  FnvCombine(tag, &key);
+  FnvCombine(static_cast<uint64_t>(f.GetValue()), &key);
+  for (int arg : f.GetArgs()) {
+    FnvCombine(static_cast<uint64_t>(arg), &key);
+  }
+  FnvCombine(static_cast<uint64_t>(bucket), &key);
+  return key;
+}
+
+// tag of a predicate from its name, which is the same in every run
+uint64_t PredicateTag(int predicate) {
+  uint64_t tag = kFnvOffset;
+  for (char c : StringRegistry::Get()->GetString(predicate)) {
+    FnvCombine(static_cast<uint64_t>(c), &tag);
+  }
+  return tag;
+}
+
+// order-independent combination of atom keys
+uint64_t CombineAtoms(vector<uint64_t> *atoms) {
+  sort(atoms->begin(), atoms->end());
+  uint64_t key = kFnvOffset;
+  for (uint64_t atom : *atoms) {
+    FnvCombine(atom, &key);
+  }
+  return key;
+}
+
+uint64_t FloatBits(float f) {
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+// Stable key of everything besides the goal that the tables depend on: the
+// file layout, the environment's parameters and the operators' names,
+// accuracies and base costs.
+uint64_t EnvironmentKey(const vector<const Operator*> &operators, const Environment &env) {
+  uint64_t key = kFnvOffset;
+  FnvCombine(sizeof(PDBHeader), &key);
+  FnvCombine(sizeof(PDBTableHeader), &key);
+  vector<int> parameters;
+  env.GetParameters(&parameters);
+  FnvCombine(parameters.size(), &key);
+  for (int parameter : parameters) {
+    FnvCombine(static_cast<uint64_t>(parameter), &key);
+  }
+  for (const Operator *o : operators) {
+    FnvCombine(PredicateTag(o->GetName()), &key);
+    FnvCombine(FloatBits(o->GetProb()), &key);
+    FnvCombine(FloatBits(o->GetObs()), &key);
+    FnvCombine(FloatBits(o->GetBaseCost()), &key);
+  }
+  return key;
+}
+
+string PatternString(const Pattern &pattern) {
+  ostringstream ss;
+  for (int i = 0; i < pattern.size(); ++i) {
+    ss << (i > 0 ? "," : "") << StringRegistry::Get()->GetString(pattern[i]);
+  }
+  return ss.str();
+}
+
+Pattern ParsePattern(const string &pattern) {
+  Pattern result;
+  istringstream ss(pattern);
+  string predicate;
+  while (getline(ss, predicate, ',')) {
+    if (!predicate.empty()) {
+      result.push_back(StringRegistry::Get()->GetInt(predicate));
+    }
+  }
+  return result;
+}
+
+bool InPattern(int predicate, const Pattern &pattern) {
+  return find(pattern.begin(), pattern.end(), predicate) != pattern.end();
+}
+
+// pattern fluents of state, with every other fluent held at its value in
+// context so that operators still find the fluents they expect
+State Project(const State &state, const Pattern &pattern, const State &context) {
+  vector<Fluent> fluents;
+  for (const Fluent &f : context.GetFluents()) {
+    if (!InPattern(f.GetPredicate(), pattern)) {
+      fluents.push_back(f);
+    }
+  }
+  for (const Fluent &f : state.GetFluents()) {
+    if (InPattern(f.GetPredicate(), pattern)) {
+      fluents.push_back(f);
+    }
+  }
+  return State(fluents);
+}
+
+// Enumerates the abstract states reachable from start_state and returns their
+// sorted keys and goal distances. Dead ends are only kept, at an infinite
+// distance, if every reachable abstract state was enumerated and the start
+// state reaches the goal. Otherwise a path through the states left out may
+// exist, or the fluents held at their start values block the goal for every
+// state, so the table says nothing about dead ends.
+void BuildTable(const State &start_state, const State &goal_state, const Pattern &pattern, const vector<const Operator*> &operators, const Environment &env, int buckets, int max_states, vector<uint64_t> *keys, vector<float> *costs) {
+  const State abstract_goal = Project(goal_state, pattern, State({}));
+
+  unordered_map<uint64_t, int> index;
+  vector<unique_ptr<State>> states;
+  // reverse_edges[to] holds (from, action cost)
+  vector<vector<pair<int, float>>> reverse_edges;
+
+  states.emplace_back(new State(start_state));
+  reverse_edges.emplace_back();
+  index[PatternKey(*states.back(), pattern, buckets)] = 0;
+
+  bool truncated = false;
+  for (int i = 0; i < states.size(); ++i) {
+    vector<unique_ptr<Action>> actions;
+    for (const Operator *o : operators) {
+      o->ApplicableActions(*states[i], env, &actions);
+    }
+    for (unique_ptr<Action> &a : actions) {
+      State successor(*states[i]);
+      a->Successor(&successor);
+      State abstract_successor = Project(successor, pattern, start_state);
+      uint64_t key = PatternKey(abstract_successor, pattern, buckets);
+
+      unordered_map<uint64_t, int>::const_iterator iter = index.find(key);
+      int j;
+      if (iter != index.end()) {
+        j = iter->second;
+      } else if (states.size() < max_states) {
+        j = states.size();
+        index[key] = j;
+        states.emplace_back(new State(abstract_successor));
+        reverse_edges.emplace_back();
+      } else {
+        truncated = true;
+        continue;
+      }
+      reverse_edges[j].emplace_back(i, a->GetCost());
+    }
+  }
+  if (truncated) {
+    cout << "pattern " << PatternString(pattern) << " truncated at " << max_states << " abstract states" << endl;
+  }
+
+  // backward Dijkstra from the abstract goal states
+  const float kInfinity = numeric_limits<float>::infinity();
+  vector<float> distance(states.size(), kInfinity);
+  typedef pair<float, int> QueueEntry;
+  priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>> queue;
+  for (int i = 0; i < states.size(); ++i) {
+    if (abstract_goal.SatisfiedBy(states[i].get())) {
+      distance[i] = 0.f;
+      queue.push(QueueEntry(0.f, i));
+    }
+  }
+  while (!queue.empty()) {
+    QueueEntry entry = queue.top();
+    queue.pop();
+    if (entry.first > distance[entry.second]) {
+      continue;
+    }
+    for (const pair<int, float> &edge : reverse_edges[entry.second]) {
+      float d = entry.first + edge.second;
+      if (d < distance[edge.first]) {
+        distance[edge.first] = d;
+        queue.push(QueueEntry(d, edge.first));
+      }
+    }
+  }
+
+  vector<pair<uint64_t, float>> entries;
+  int num_reach_goal = 0;
+  for (const pair<const uint64_t, int> &entry : index) {
+    if (distance[entry.second] < kInfinity) {
+      num_reach_goal++;
+    }
+    if (distance[entry.second] < kInfinity || (!truncated && distance[0] < kInfinity)) {
+      entries.emplace_back(entry.first, distance[entry.second]);
+    }
+  }
+  sort(entries.begin(), entries.end());
+  for (const pair<uint64_t, float> &entry : entries) {
+    keys->push_back(entry.first);
+    costs->push_back(entry.second);
+  }
+
+  cout << "pattern " << PatternString(pattern) << ": " << states.size() << " abstract states, " << num_reach_goal << " reach the goal, h(start) = " << distance[0] << endl;
+}
+
+} // namespace
+
+vector<Pattern> ParsePatterns(const string &patterns, const State &goal_state) {
+  vector<Pattern> result;
+  if (patterns.empty()) {
+    Pattern pattern;
+    for (const Fluent &f : goal_state.GetFluents()) {
+      if (!InPattern(f.GetPredicate(), pattern)) {
+        pattern.push_back(f.GetPredicate());
+      }
+    }
+    result.push_back(pattern);
+  } else {
+    istringstream ss(patterns);
+    string pattern;
+    while (getline(ss, pattern, ';')) {
+      if (!pattern.empty()) {
+        result.push_back(ParsePattern(pattern));
+      }
+    }
+  }
+  return result;
+}
+
+uint64_t PatternKey(const State &state, const Pattern &pattern, int buckets) {
+  vector<uint64_t> atoms;
+  for (const Fluent &f : state.GetFluents()) {
+    for (int i = 0; i < pattern.size(); ++i) {
+      if (f.GetPredicate() == pattern[i]) {
+        // fluents that round to 0 are the same as absent fluents
+        int bucket = static_cast<int>(f.GetProb() * buckets);
+        if (bucket > 0) {
+          atoms.push_back(AtomKey(i, f, bucket));
+        }
+        break;
+      }
+    }
+  }
+  return CombineAtoms(&atoms);
+}
+
+uint64_t GoalKey(const State &goal_state) {
+  vector<uint64_t> atoms;
+  for (const Fluent &f : goal_state.GetFluents()) {
+    atoms.push_back(AtomKey(PredicateTag(f.GetPredicate()), f, static_cast<int>(f.RoundProb(f.GetProb()))));
+  }
+  return CombineAtoms(&atoms);
+}
+
+uint64_t StateKey(const State &state) {
+  vector<uint64_t> atoms;
+  for (const Fluent &f : state.GetFluents()) {
+    int bucket = static_cast<int>(f.RoundProb(f.GetProb()));
+    if (bucket > 0) {
+      atoms.push_back(AtomKey(PredicateTag(f.GetPredicate()), f, bucket));
+    }
+  }
+  return CombineAtoms(&atoms);
+}
+
+bool BuildPatternDatabase(const State &start_state, const State &goal_state, const vector<Pattern> &patterns, const vector<const Operator*> &operators, const Environment &env, int buckets, int max_states, const string &file_name) {
+  vector<PDBTableHeader> table_headers;
+  vector<vector<uint64_t>> keys(patterns.size());
+  vector<vector<float>> costs(patterns.size());
+
+  uint64_t offset = sizeof(PDBHeader) + patterns.size() * sizeof(PDBTableHeader);
+  for (int i = 0; i < patterns.size(); ++i) {
+    const string pattern = PatternString(patterns[i]);
+    if (patterns[i].empty() || pattern.size() >= sizeof(PDBTableHeader().pattern)) {
+      cerr << "Invalid pattern '" << pattern << "'" << endl;
+      return false;
+    }
+    BuildTable(start_state, goal_state, patterns[i], operators, env, buckets, max_states, &keys[i], &costs[i]);
+
+    PDBTableHeader table_header;
+    memset(&table_header, 0, sizeof(table_header));
+    strncpy(table_header.pattern, pattern.c_str(), sizeof(table_header.pattern) - 1);
+    table_header.offset = offset;
+    table_header.num_entries = keys[i].size();
+    table_headers.push_back(table_header);
+
+    offset += keys[i].size() * (sizeof(uint64_t) + sizeof(float));
+    offset = (offset + 7) & ~static_cast<uint64_t>(7);
+  }
+
+  PDBHeader header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_tables = patterns.size();
+  header.goal_key = GoalKey(goal_state);
+  header.environment_key = EnvironmentKey(operators, env);
+  header.buckets = buckets;
+  header.padding = 0;
+
+  ofstream out(file_name, ios::binary);
+  if (!out) {
+    cerr << "Could not open '" << file_name << "' for writing" << endl;
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const PDBTableHeader &table_header : table_headers) {
+    out.write(reinterpret_cast<const char*>(&table_header), sizeof(table_header));
+  }
+  for (int i = 0; i < patterns.size(); ++i) {
+    out.write(reinterpret_cast<const char*>(keys[i].data()), keys[i].size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(costs[i].data()), costs[i].size() * sizeof(float));
+    while (out.tellp() % 8 != 0) {
+      out.put('\0');
+    }
+  }
+  if (!out) {
+    cerr << "Could not write '" << file_name << "'" << endl;
+    return false;
+  }
+  cout << "wrote " << patterns.size() << " pattern database tables to " << file_name << endl;
+  return true;
+}
+
+// HPDB
+
+HPDB::HPDB(const Heuristic &fallback) : fallback_(fallback), data_(nullptr), size_(0), buckets_(0), goal_state_(nullptr) {}
+
+HPDB::~HPDB() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+bool HPDB::Load(const string &file_name, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    cerr << "Could not open pattern database '" << file_name << "'" << endl;
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < sizeof(PDBHeader)) {
+    cerr << "Invalid pattern database '" << file_name << "'" << endl;
+    close(fd);
+    return false;
+  }
+  void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    cerr << "Could not map pattern database '" << file_name << "'" << endl;
+    return false;
+  }
+  data_ = data;
+  size_ = st.st_size;
+
+  const char *bytes = static_cast<const char*>(data_);
+  const PDBHeader *header = reinterpret_cast<const PDBHeader*>(bytes);
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion || header->buckets == 0 ||
+      size_ < sizeof(PDBHeader) + header->num_tables * sizeof(PDBTableHeader)) {
+    cerr << "Invalid pattern database '" << file_name << "'" << endl;
+    return false;
+  }
+  buckets_ = header->buckets;
+
+  if (header->environment_key != EnvironmentKey(operators, env)) {
+    cerr << "Pattern database '" << file_name << "' was built for a different environment or operators" << endl;
+    return false;
+  }
+
+  for (const State *goal_state : goal_set) {
+    if (GoalKey(*goal_state) == header->goal_key) {
+      goal_state_ = goal_state;
+      break;
+    }
+  }
+  if (goal_state_ == nullptr) {
+    cerr << "Pattern database '" << file_name << "' was built for a different goal" << endl;
+    return false;
+  }
+
+  const PDBTableHeader *table_headers = reinterpret_cast<const PDBTableHeader*>(bytes + sizeof(PDBHeader));
+  for (int i = 0; i < header->num_tables; ++i) {
+    const PDBTableHeader &table_header = table_headers[i];
+    if (table_header.offset + table_header.num_entries * (sizeof(uint64_t) + sizeof(float)) > size_) {
+      cerr << "Invalid pattern database '" << file_name << "'" << endl;
+      return false;
+    }
+    Table table;
+    table.pattern = ParsePattern(string(table_header.pattern, strnlen(table_header.pattern, sizeof(table_header.pattern))));
+    table.keys = reinterpret_cast<const uint64_t*>(bytes + table_header.offset);
+    table.costs = reinterpret_cast<const float*>(table.keys + table_header.num_entries);
+    table.size = table_header.num_entries;
+    tables_.push_back(table);
+  }
+  return true;
+}
+
+// pattern database heuristic: maximum over the mmapped tables of the abstract
+// goal distance, or the fallback heuristic if no table has the projection
+float HPDB::Cost(const State &initial_state, const State &goal_state, const vector<const Operator*> &operators, const Environment& env) const {
+  if (&goal_state != goal_state_) {
+    return fallback_.Cost(initial_state, goal_state, operators, env);
+  }
+  float cost = -1.f;
+  for (const Table &table : tables_) {
+    uint64_t key = PatternKey(initial_state, table.pattern, buckets_);
+    const uint64_t *iter = lower_bound(table.keys, table.keys + table.size, key);
+    if (iter != table.keys + table.size && *iter == key) {
+      cost = max(cost, table.costs[iter - table.keys]);
+    }
+  }
+  return (cost < 0.f) ? fallback_.Cost(initial_state, goal_state, operators, env) : cost;
+}
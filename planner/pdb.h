@@ -0,0 +1,85 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PDB_H
+#define PDB_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "support.h"
+
+// A pattern is a set of predicates. Projecting a State onto a pattern keeps
+// only the fluents of those predicates; two projections whose probabilities
+// fall into the same buckets (of width 1 / buckets) share a key.
+typedef std::vector<int> Pattern;
+
+// Parses "conf,held;obj_loc" into patterns. An empty string gives a single
+// pattern made of every predicate that appears in the goal.
+std::vector<Pattern> ParsePatterns(const std::string &patterns, const State &goal_state);
+
+// Stable (across runs) key of the projection of state onto pattern.
+uint64_t PatternKey(const State &state, const Pattern &pattern, int buckets);
+
+// Stable key of a goal state, used to check that tables match the problem.
+uint64_t GoalKey(const State &goal_state);
+
+// Stable key of a whole state, with probabilities rounded as in
+// Fluent::RoundProb. Fluents that round to 0 are the same as absent fluents.
+uint64_t StateKey(const State &state);
+
+// Enumerates the abstract state space of every pattern forward from the start
+// state (fluents outside the pattern stay at their start values), runs a
+// backward Dijkstra from the abstract goal states and writes all tables to
+// file_name.
+bool BuildPatternDatabase(const State &start_state, const State &goal_state, const std::vector<Pattern> &patterns, const std::vector<const Operator*> &operators, const Environment &env, int buckets, int max_states, const std::string &file_name);
+
+// pattern database heuristic: maximum over the mmapped tables of the abstract
+// goal distance, or the fallback heuristic if no table has the projection.
+// Infinite for abstract dead ends, which the default search drops.
+class HPDB : public Heuristic {
+ public:
+  // fallback must outlive the HPDB
+  HPDB(const Heuristic &fallback);
+
+  ~HPDB();
+
+  // Maps file_name into memory and checks that it was built for one of the
+  // goals in goal_set, with the same environment parameters and operators.
+  bool Load(const std::string &file_name, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env);
+
+  float Cost(const State &initial_state, const State &goal_state, const std::vector<const Operator*> &operators, const Environment& env) const override;
+
+ private:
+  struct Table {
+    Pattern pattern;
+    const uint64_t *keys; // sorted
+    const float *costs;
+    uint64_t size;
+  };
+
+  const Heuristic &fallback_;
+  void *data_;
+  size_t size_;
+  int buckets_;
+  const State *goal_state_;
+  std::vector<Table> tables_;
+};
+
+#endif  // PDB_H
@@ -0,0 +1,139 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "portfolio.h"
+
+using namespace std;
+
+namespace {
+
+struct Configuration {
+  string name;
+  const Heuristic *h;
+  float weight;
+  float epsilon;
+};
+
+// nullptr for an unknown name, default is h
+const Heuristic* GetHeuristic(const string &name, const Heuristic &h, vector<unique_ptr<Heuristic>> *heuristics) {
+  if (name == "default") {
+    return &h;
+  } else if (name == "zero") {
+    heuristics->emplace_back(new HZero());
+  } else if (name == "max") {
+    heuristics->emplace_back(new HMax());
+  } else if (name == "hsp") {
+    heuristics->emplace_back(new HHSP());
+  } else if (name == "ff") {
+    heuristics->emplace_back(new HFF());
+  } else {
+    return nullptr;
+  }
+  return heuristics->back().get();
+}
+
+bool ParseFloat(const string &str, float *value) {
+  char *end = nullptr;
+  *value = strtof(str.c_str(), &end);
+  return !str.empty() && *end == '\0';
+}
+
+bool ParseConfigurations(const string &portfolio, const Heuristic &h, float weight, vector<unique_ptr<Heuristic>> *heuristics, vector<Configuration> *configurations) {
+  stringstream configs(portfolio);
+  string config;
+  while (getline(configs, config, ',')) {
+    stringstream fields(config);
+    vector<string> parts;
+    string part;
+    while (getline(fields, part, ':')) {
+      parts.push_back(part);
+    }
+    Configuration configuration = {config, nullptr, weight, 0.f};
+    if (parts.empty() || parts.size() > 3 ||
+        (configuration.h = GetHeuristic(parts[0], h, heuristics)) == nullptr ||
+        (parts.size() > 1 && !ParseFloat(parts[1], &configuration.weight)) ||
+        (parts.size() > 2 && !ParseFloat(parts[2], &configuration.epsilon))) {
+      cerr << "invalid portfolio configuration '" << config << "'" << endl;
+      return false;
+    }
+    configurations->push_back(configuration);
+  }
+  return true;
+}
+
+} // namespace
+
+bool PortfolioSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  vector<unique_ptr<Heuristic>> heuristics;
+  vector<Configuration> configurations;
+  if (!ParseConfigurations(options.portfolio, h, options.weight, &heuristics, &configurations)) {
+    return false;
+  }
+
+  // set by the first search to find a goal, the others give up when they see it
+  atomic<bool> cancelled(false);
+  atomic<int> winner(-1);
+  vector<vector<SearchNode::PathPair>> paths(configurations.size());
+  vector<vector<float>> path_costs(configurations.size());
+
+  vector<thread> threads;
+  for (int i = 0; i < configurations.size(); ++i) {
+    SearchOptions config_options = options;
+    config_options.portfolio.clear();
+    config_options.weight = configurations[i].weight;
+    config_options.epsilon = configurations[i].epsilon;
+    config_options.quiet = true;
+    config_options.cancelled = &cancelled;
+    threads.emplace_back([&, i, config_options]() {
+      unique_ptr<const State> state(new State(*initial_state));
+      if (UCSearch(move(state), goal_set, operators, *configurations[i].h, env, &paths[i], &path_costs[i], nullptr, false, config_options)) {
+        int none = -1;
+        if (winner.compare_exchange_strong(none, i)) {
+          cancelled = true;
+        }
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  if (winner < 0) {
+    cout << "no configuration of the portfolio found a plan" << endl;
+    // interrupted searches leave a partial plan, take the first one
+    for (int i = 0; i < configurations.size(); ++i) {
+      if (!paths[i].empty()) {
+        cout << "returning the partial plan of configuration " << configurations[i].name << endl;
+        *path = move(paths[i]);
+        *costs = move(path_costs[i]);
+        break;
+      }
+    }
+    return false;
+  }
+  // the searches are quiet, so the winner is reported here
+  cout << "portfolio configuration " << configurations[winner].name << " found a plan first, solution cost: " << path_costs[winner].front() << endl;
+  cout << "satisfies goal state " << *SatisfiedGoal(goal_set, paths[winner].front().state) << endl;
+  *path = move(paths[winner]);
+  *costs = move(path_costs[winner]);
+  return true;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Runs UCSearch for every configuration in options.portfolio on its own
+// thread and returns the plan of the first one to find a goal, cancelling
+// the others.
+//
+// options.portfolio is a comma separated list of heuristic[:weight[:epsilon]]
+// where heuristic is one of default (h), zero, max, hsp or ff, weight
+// defaults to options.weight and epsilon to 0, e.g. "default:0.35,zero:0.5".
+//
+// this function will take ownership of initial_state
+bool PortfolioSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // PORTFOLIO_H
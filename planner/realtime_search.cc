@@ -0,0 +1,290 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+#include "pdb.h"
+#include "realtime_search.h"
+#include "string_registry.h"
+
+using namespace std;
+
+namespace {
+
+const char kMagic[] = "sasy-lrta";
+const int kVersion = 1;
+
+// (cost plus heuristic cost, count, node), cheapest and then oldest first
+typedef tuple<float, int, const SearchNode*> Entry;
+typedef priority_queue<Entry, vector<Entry>, greater<Entry>> Queue;
+
+typedef unordered_map<const State*, const SearchNode*, StatePtrHash, StatePtrEqual> BestNodes;
+
+} // namespace
+
+// LearnedTable
+
+LearnedTable::LearnedTable() : has_goal_(false), goal_key_(0) {}
+
+bool LearnedTable::Get(const State &state, float *cost) const {
+  unordered_map<uint64_t, float>::const_iterator iter = costs_.find(StateKey(state));
+  if (iter == costs_.end()) {
+    return false;
+  }
+  *cost = iter->second;
+  return true;
+}
+
+void LearnedTable::Set(const State &state, float cost) {
+  costs_[StateKey(state)] = cost;
+}
+
+int LearnedTable::Size() const {
+  return costs_.size();
+}
+
+bool LearnedTable::ForGoal(const vector<const State*> &goal_set) const {
+  if (!has_goal_) {
+    return false;
+  }
+  for (const State *goal_state : goal_set) {
+    if (GoalKey(*goal_state) == goal_key_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LearnedTable::Reset(const vector<const State*> &goal_set) {
+  has_goal_ = true;
+  goal_key_ = GoalKey(*goal_set[0]);
+  costs_.clear();
+}
+
+bool LearnedTable::Load(const string &file_name, const vector<const State*> &goal_set) {
+  Reset(goal_set);
+  ifstream in(file_name);
+  if (!in) {
+    cout << "no learned costs in '" << file_name << "' yet" << endl;
+    return true;
+  }
+
+  string magic;
+  int version;
+  uint64_t goal_key;
+  int num_entries;
+  if (!(in >> magic >> version >> goal_key >> num_entries) || magic != kMagic || version != kVersion) {
+    cerr << "Invalid learned costs '" << file_name << "'" << endl;
+    return false;
+  }
+  bool known_goal = false;
+  for (const State *goal_state : goal_set) {
+    known_goal = known_goal || GoalKey(*goal_state) == goal_key;
+  }
+  if (!known_goal) {
+    cerr << "Learned costs '" << file_name << "' were learned for a different goal" << endl;
+    has_goal_ = false;
+    return false;
+  }
+  goal_key_ = goal_key;
+
+  for (int i = 0; i < num_entries; ++i) {
+    // read the cost as a word, since operator>> does not parse the "inf"
+    // written for dead ends
+    uint64_t key;
+    string cost;
+    char *end = nullptr;
+    if (in >> key >> cost) {
+      costs_[key] = strtof(cost.c_str(), &end);
+    }
+    if (!in || end != cost.c_str() + cost.size()) {
+      cerr << "Invalid learned costs '" << file_name << "'" << endl;
+      return false;
+    }
+  }
+  cout << "loaded " << costs_.size() << " learned costs from " << file_name << endl;
+  return true;
+}
+
+bool LearnedTable::Save(const string &file_name) const {
+  ofstream out(file_name);
+  if (!out) {
+    cerr << "Could not open '" << file_name << "' for writing" << endl;
+    return false;
+  }
+  out << kMagic << " " << kVersion << " " << goal_key_ << " " << costs_.size() << endl;
+  out << setprecision(9);
+  for (const pair<const uint64_t, float> &entry : costs_) {
+    out << entry.first << " " << entry.second << endl;
+  }
+  if (!out) {
+    cerr << "Could not write '" << file_name << "'" << endl;
+    return false;
+  }
+  cout << "wrote " << costs_.size() << " learned costs to " << file_name << endl;
+  return true;
+}
+
+bool RealTimeSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, LearnedTable *table, const SearchOptions &options) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  if (options.lrta_lookahead <= 0) {
+    cerr << "real-time search needs a positive lookahead" << endl;
+    return false;
+  }
+
+  // learned cost of state, or its heuristic cost if none was learned
+  auto learned_cost = [&](const State &state) {
+    float cost;
+    if (!table->Get(state, &cost)) {
+      cost = HeuristicCost(h, state, goal_set, operators, env);
+    }
+    return cost;
+  };
+
+  // nodes of the states the agent went through, the initial node first
+  vector<unique_ptr<SearchNode>> taken;
+
+  int count_steps = 0;
+  int count_expanded = 0;
+  int count_updates = 0;
+
+  float initial_heuristic_cost = learned_cost(*initial_state);
+  taken.emplace_back(new SearchNode(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, count_steps, 0.f));
+
+  while (SatisfiedGoal(goal_set, *taken.back()->GetState()) == nullptr) {
+    if (options.lrta_steps > 0 && count_steps >= options.lrta_steps) {
+      cout << "took " << count_steps << " steps, " << count_expanded << " nodes expanded, " << count_updates << " costs learned, " << table->Size() << " learned costs in total, cost so far: " << taken.back()->GetParentActionCost() << endl;
+      taken.back()->GetPath(path);
+      taken.back()->GetCosts(costs);
+      return true;
+    }
+    if (options.Interrupted()) {
+      ReturnInterruptedPlan(*taken.back(), count_expanded, "the current state with learned cost", taken.back()->GetHeuristicCost(), options, path, costs);
+      return false;
+    }
+
+    // lookahead: A* from the current state
+    vector<unique_ptr<SearchNode>> visited;
+    BestNodes best_nodes;
+    vector<const SearchNode*> expanded;
+    Queue agenda;
+    int count_visited = 0;
+    visited.emplace_back(new SearchNode(unique_ptr<const State>(new State(*taken.back()->GetState())), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), learned_cost(*taken.back()->GetState()), ++count_visited, 0.f));
+    const SearchNode *root = visited.back().get();
+    best_nodes[root->GetState()] = root;
+    agenda.push(Entry(root->GetCost(), count_visited, root));
+
+    // best node left once the lookahead is used up, or the first goal node
+    const SearchNode *best = nullptr;
+    while (!agenda.empty()) {
+      const SearchNode *node = get<2>(agenda.top());
+      const State *state = node->GetState();
+      if (best_nodes.find(state)->second != node) {
+        agenda.pop();
+        continue;
+      }
+      if (SatisfiedGoal(goal_set, *state) != nullptr || expanded.size() >= options.lrta_lookahead) {
+        best = node;
+        break;
+      }
+      agenda.pop();
+      expanded.push_back(node);
+      count_expanded++;
+
+      vector<unique_ptr<Action>> actions;
+      node->Actions(operators, env, &actions);
+      vector<unique_ptr<State>> new_states(actions.size());
+      vector<float> heuristic_costs(actions.size());
+      vector<const State*> eval_states;
+      vector<int> eval_indices;
+      for (int i = 0; i < actions.size(); ++i) {
+        unique_ptr<State> new_state = node->CreateSuccessor(*actions[i], false);
+        BestNodes::const_iterator prev = best_nodes.find(new_state.get());
+        if (prev != best_nodes.end() && node->GetParentActionCost() + actions[i]->GetCost() >= prev->second->GetParentActionCost()) {
+          continue;
+        }
+        if (!table->Get(*new_state, &heuristic_costs[i])) {
+          eval_states.push_back(new_state.get());
+          eval_indices.push_back(i);
+        }
+        new_states[i] = move(new_state);
+      }
+      for (int i = 0; i < eval_indices.size(); ++i) {
+        heuristic_costs[eval_indices[i]] = h.MinCost(*eval_states[i], goal_set, operators, env);
+      }
+
+      for (int i = 0; i < actions.size(); ++i) {
+        if (new_states[i] == nullptr) {
+          continue;
+        }
+        // an earlier sibling may have reached the state since it was checked
+        BestNodes::iterator prev = best_nodes.find(new_states[i].get());
+        if (prev != best_nodes.end() && node->GetParentActionCost() + actions[i]->GetCost() >= prev->second->GetParentActionCost()) {
+          continue;
+        }
+        visited.emplace_back(new SearchNode(move(new_states[i]), node, move(actions[i]), heuristic_costs[i], ++count_visited, 0.f));
+        const SearchNode *child = visited.back().get();
+        if (prev != best_nodes.end()) {
+          best_nodes.erase(prev);
+        }
+        best_nodes[child->GetState()] = child;
+        agenda.push(Entry(child->GetCost(), count_visited, child));
+      }
+    }
+
+    if (best == nullptr) {
+      cout << "no goal state can be reached from the current state, " << count_steps << " steps taken" << endl;
+      table->Set(*root->GetState(), numeric_limits<float>::infinity());
+      taken.back()->GetPath(path);
+      taken.back()->GetCosts(costs);
+      return false;
+    }
+
+    // the learned costs only grow, so that the agent does not loop forever
+    for (const SearchNode *node : expanded) {
+      float cost = best->GetCost() - node->GetParentActionCost();
+      if (cost > node->GetHeuristicCost()) {
+        table->Set(*node->GetState(), cost);
+        count_updates++;
+      }
+    }
+
+    // take the first action towards best
+    const SearchNode *next = best;
+    while (next->GetParent() != root) {
+      next = next->GetParent();
+    }
+    unique_ptr<State> new_state = taken.back()->CreateSuccessor(next->GetAction(), false);
+    float heuristic_cost = next->GetHeuristicCost();
+    table->Get(*new_state, &heuristic_cost);
+    taken.emplace_back(new SearchNode(move(new_state), taken.back().get(), unique_ptr<const Action>(new Action(next->GetAction())), heuristic_cost, ++count_steps, 0.f));
+    if (!options.quiet) {cout << "step " << count_steps << ": " << next->GetAction().GetPlanString() << ", " << expanded.size() << " nodes expanded, lookahead cost: " << best->GetCost() << endl;}
+  }
+
+  cout << "found goal state! " << count_steps << " steps, " << count_expanded << " nodes expanded, " << count_updates << " costs learned, " << table->Size() << " learned costs in total, solution cost: " << taken.back()->GetParentActionCost() << endl;
+  cout << "satisfies goal state " << *SatisfiedGoal(goal_set, *taken.back()->GetState()) << endl;
+  taken.back()->GetPath(path);
+  taken.back()->GetCosts(costs);
+  return true;
+}
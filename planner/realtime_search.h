@@ -0,0 +1,81 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALTIME_SEARCH_H
+#define REALTIME_SEARCH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Heuristic costs learned by RealTimeSearch, keyed by StateKey (see pdb.h) so
+// that they can be saved and used again by later runs on the same goal.
+class LearnedTable {
+ public:
+  LearnedTable();
+
+  // false if no cost was learned for state
+  bool Get(const State &state, float *cost) const;
+
+  void Set(const State &state, float cost);
+
+  int Size() const;
+
+  // true if the costs were learned for a goal in goal_set
+  bool ForGoal(const std::vector<const State*> &goal_set) const;
+
+  // forgets all costs, the ones learned next are for goal_set
+  void Reset(const std::vector<const State*> &goal_set);
+
+  // Replaces the costs with the ones in the file. A missing file is an empty
+  // table. Fails if the file is invalid or was learned for a goal that is not
+  // in goal_set.
+  bool Load(const std::string &file_name, const std::vector<const State*> &goal_set);
+
+  // dead ends have an infinite cost, written as inf
+  bool Save(const std::string &file_name) const;
+
+ private:
+  bool has_goal_;
+  uint64_t goal_key_;
+  std::unordered_map<uint64_t, float> costs_;
+};
+
+// Real-time search (LRTA* with an A* lookahead, as in RTAA*). Every step runs
+// an A* on cost plus heuristic cost from the current state for at most
+// options.lrta_lookahead expansions, raises the learned heuristic cost of
+// every expanded state s to f - g(s), where f is the cost plus heuristic cost
+// of the best node left in the lookahead, and then takes the first action
+// towards that node. States without a learned cost use h.
+//
+// Stops at a goal state or after options.lrta_steps steps if positive, so
+// that with a single step only the next action is returned, in time bounded
+// by the lookahead. path and costs hold the actions taken. The learned costs
+// are kept in table, which should be passed again for later runs, either by a
+// resident planner (see SearchOptions::learned_table) or through a file.
+//
+// this function will take ownership of initial_state
+bool RealTimeSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, LearnedTable *table, const SearchOptions &options);
+
+#endif  // REALTIME_SEARCH_H
@@ -0,0 +1,251 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+#include <unordered_set>
+
+#include "relevance.h"
+
+using namespace std;
+
+namespace {
+
+// layers of the add-only relaxation explored while grounding, they only add
+// to the actions met in the real states
+const int kMaxRelaxedLayers = 100;
+// the grounding walk must tell apart states that search would merge
+struct StatePtrExactEqual {
+  bool operator()(const State *a, const State *b) const {
+    return *a == *b;
+  }
+};
+
+} // namespace
+
+// Relevance
+
+Relevance::Relevance(const State &start_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, int max_states) : max_states_(max_states), complete_(true), num_relevant_actions_(0), num_relevant_fluents_(0) {
+  for (const Fluent &f : start_state.GetFluents()) {
+    fluents_.insert(f);
+  }
+  vector<Fluent> irrelevant;
+  env.GetIrrelevantFluents(start_state, goal_set, &irrelevant);
+  irrelevant_.insert(irrelevant.begin(), irrelevant.end());
+
+  // ground the actions of every layer of the add-only relaxation, this reaches
+  // all actions whose operators only test fluents for being above a threshold
+  State relaxed_state(start_state);
+  for (int layer = 0; layer < kMaxRelaxedLayers; ++layer) {
+    vector<unique_ptr<Action>> actions;
+    for (const Operator *o : operators) {
+      o->ApplicableActions(relaxed_state, env, &actions);
+    }
+    Ground(relaxed_state, actions);
+
+    const State prev_state(relaxed_state);
+    for (const unique_ptr<Action> &action : actions) {
+      action->AddSuccessor(&relaxed_state);
+    }
+    if (relaxed_state == prev_state) {
+      break;
+    }
+  }
+
+  // ground the actions of the real states breadth first, for operators that
+  // test fluents for exact values. Only a walk over every reachable state
+  // meets every ground action in every state it applies in; past the bound
+  // the analysis keeps everything but what the domain rules out
+  unordered_set<const State*, StatePtrHash, StatePtrExactEqual> seen;
+  vector<unique_ptr<State>> states;
+  states.emplace_back(new State(start_state));
+  seen.insert(states.back().get());
+  for (int i = 0; i < states.size() && complete_; ++i) {
+    vector<unique_ptr<Action>> actions;
+    for (const Operator *o : operators) {
+      o->ApplicableActions(*states[i], env, &actions);
+    }
+    Ground(*states[i], actions);
+
+    for (const unique_ptr<Action> &action : actions) {
+      unique_ptr<State> new_state(new State(*states[i]));
+      action->Successor(new_state.get());
+      if (seen.count(new_state.get()) == 0) {
+        if (states.size() >= max_states_) {
+          complete_ = false;
+          break;
+        }
+        seen.insert(new_state.get());
+        states.push_back(move(new_state));
+      }
+    }
+  }
+
+  // backward from the goal: an action is relevant if it raises a relevant
+  // fluent, and everything a relevant action reads is relevant
+  for (const State *goal_state : goal_set) {
+    for (const Fluent &f : goal_state->GetFluents()) {
+      relevant_.insert(f);
+    }
+  }
+  bool changed = complete_;
+  while (changed) {
+    changed = false;
+    for (auto &entry : actions_) {
+      GroundAction &action = entry.second;
+      if (!action.relevant) {
+        for (const Fluent &f : action.raises) {
+          if (relevant_.count(f) > 0) {
+            action.relevant = true;
+            break;
+          }
+        }
+        if (action.relevant) {
+          ++num_relevant_actions_;
+          relevant_.insert(action.reads.begin(), action.reads.end());
+          changed = true;
+        }
+      }
+    }
+  }
+  if (!complete_) {
+    num_relevant_actions_ = actions_.size();
+  }
+  for (const Fluent &f : fluents_) {
+    if (IsRelevant(f)) {
+      ++num_relevant_fluents_;
+    }
+  }
+}
+
+void Relevance::Ground(const State &state, const vector<unique_ptr<Action>> &actions) {
+  for (const unique_ptr<Action> &action : actions) {
+    // value initialized (not relevant) the first time the action is met
+    GroundAction &ground_action = actions_[Signature(*action)];
+    for (const Fluent &f : action->GetPreconditions()) {
+      ground_action.reads.insert(f);
+      fluents_.insert(f);
+    }
+    for (const Fluent &f : action->GetDeleteList()) {
+      ground_action.reads.insert(f);
+      fluents_.insert(f);
+    }
+    // probabilities are clamped at 1, so an unchanged non-zero probability
+    // may still be raised from another state
+    for (const Fluent &f : action->GetAddList()) {
+      fluents_.insert(f);
+      const float prev_prob = state.GetProb(f);
+      if (f.GetProb() > prev_prob || (f.GetProb() == prev_prob && prev_prob > 0.f)) {
+        ground_action.raises.insert(f);
+      }
+    }
+  }
+}
+
+// actions with the same name, info and add list fluents (ignoring their
+// probabilities) are the same ground action
+size_t Relevance::Signature(const Action &action) {
+  size_t seed = 0;
+  HashCombine(action.GetName(), &seed);
+  for (int i : action.GetInfo()) {
+    HashCombine(i, &seed);
+  }
+  for (const Fluent &f : action.GetAddList()) {
+    HashCombine(f.HashExcludingProb(), &seed);
+  }
+  return seed;
+}
+
+bool Relevance::IsRelevant(const Action &action) const {
+  if (!complete_) {
+    return true;
+  }
+  unordered_map<size_t, GroundAction>::const_iterator iter = actions_.find(Signature(action));
+  return (iter == actions_.end()) || iter->second.relevant;
+}
+
+bool Relevance::IsRelevant(const Fluent &fluent) const {
+  if (irrelevant_.count(fluent) > 0) {
+    return false;
+  }
+  return !complete_ || (fluents_.count(fluent) == 0) || (relevant_.count(fluent) > 0);
+}
+
+unique_ptr<State> Relevance::Prune(const State &state) const {
+  vector<Fluent> fluents;
+  for (const Fluent &f : state.GetFluents()) {
+    if (IsRelevant(f)) {
+      fluents.push_back(f);
+    }
+  }
+  return unique_ptr<State>(new State(fluents));
+}
+
+unique_ptr<Action> Relevance::Prune(unique_ptr<Action> action) const {
+  if (!IsRelevant(*action)) {
+    return nullptr;
+  }
+
+  bool all_relevant = true;
+  for (const vector<Fluent> *fluents : {&action->GetPreconditions(), &action->GetAddList(), &action->GetDeleteList()}) {
+    for (const Fluent &f : *fluents) {
+      all_relevant = all_relevant && IsRelevant(f);
+    }
+  }
+  if (all_relevant) {
+    return action;
+  }
+
+  vector<Fluent> lists[3];
+  const vector<Fluent> *fluents[3] = {&action->GetPreconditions(), &action->GetAddList(), &action->GetDeleteList()};
+  for (int i = 0; i < 3; ++i) {
+    for (const Fluent &f : *fluents[i]) {
+      if (IsRelevant(f)) {
+        lists[i].push_back(f);
+      }
+    }
+  }
+  return unique_ptr<Action>(new Action(action->GetName(), action->GetCost(), lists[0], lists[1], lists[2], action->GetInfo()));
+}
+
+bool Relevance::PrunesAny() const {
+  return (num_relevant_actions_ < actions_.size()) || (num_relevant_fluents_ < fluents_.size());
+}
+
+string Relevance::GetString() const {
+  ostringstream ss;
+  ss << "relevance analysis ";
+  if (!complete_) {
+    ss << "stopped grounding after " << max_states_ << " states and ";
+  }
+  ss << "kept " << num_relevant_actions_ << " of " << actions_.size() << " ground actions and ";
+  ss << num_relevant_fluents_ << " of " << fluents_.size() << " fluents";
+  return ss.str();
+}
+
+// RelevantOperator
+
+RelevantOperator::RelevantOperator(const Operator &op, const Relevance &relevance) : Operator(op.GetName(), op.GetProb(), op.GetObs(), op.GetBaseCost(), 1.f, false), op_(op), relevance_(relevance) {}
+
+void RelevantOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
+  vector<unique_ptr<Action>> op_actions;
+  op_.ApplicableActions(state, env, &op_actions);
+  for (unique_ptr<Action> &action : op_actions) {
+    unique_ptr<Action> pruned_action = relevance_.Prune(move(action));
+    if (pruned_action != nullptr) {
+      actions->push_back(move(pruned_action));
+    }
+  }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RELEVANCE_H
+#define RELEVANCE_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "environment.h"
+#include "operator.h"
+#include "support.h"
+
+// Backward relevance analysis from the goal over the ground actions met by
+// exploring forward from the start state (both in the add-only relaxation and
+// over the real states).
+//
+// A fluent is relevant if it is in a goal or read by a relevant action, and an
+// action is relevant if it raises the probability of a relevant fluent.
+// Actions that were never met while grounding are kept. This is only sound
+// once every reachable state was grounded, so when there are more than
+// max_states of them every action and fluent is kept, except the fluents
+// the environment rules out (see Environment::GetIrrelevantFluents).
+class Relevance {
+ public:
+  // grounds at most max_states real states
+  Relevance(const State &start_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env, int max_states);
+
+  bool IsRelevant(const Action &action) const;
+
+  bool IsRelevant(const Fluent &fluent) const;
+
+  // copy of state without the irrelevant fluents
+  std::unique_ptr<State> Prune(const State &state) const;
+
+  // nullptr if action is irrelevant, otherwise action without the irrelevant
+  // fluents in its lists
+  std::unique_ptr<Action> Prune(std::unique_ptr<Action> action) const;
+
+  // true if some ground action or fluent is irrelevant
+  bool PrunesAny() const;
+
+  std::string GetString() const;
+
+ private:
+  struct GroundAction {
+    FluentExcludingProbSet raises;
+    FluentExcludingProbSet reads;
+    bool relevant;
+  };
+
+  void Ground(const State &state, const std::vector<std::unique_ptr<Action>> &actions);
+
+  static size_t Signature(const Action &action);
+
+  std::unordered_map<size_t, GroundAction> actions_;
+  FluentExcludingProbSet fluents_; // every fluent met while grounding
+  FluentExcludingProbSet relevant_;
+  FluentExcludingProbSet irrelevant_; // ruled out by the environment
+  const int max_states_;
+  // every reachable state was grounded
+  bool complete_;
+  int num_relevant_actions_;
+  int num_relevant_fluents_;
+};
+
+// Wraps an operator, dropping its irrelevant actions and the irrelevant
+// fluents of the others. op and relevance must outlive the RelevantOperator.
+class RelevantOperator : public Operator {
+ public:
+  RelevantOperator(const Operator &op, const Relevance &relevance);
+
+  void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const override;
+
+  bool IsMacro() const override {
+    return op_.IsMacro();
+  }
+
+ private:
+  const Operator &op_;
+  const Relevance &relevance_;
+};
+
+#endif  // RELEVANCE_H
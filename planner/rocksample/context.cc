@@ -32,7 +32,7 @@ namespace rocksample {
 
 using namespace std;
 
-bool RockSample(bool verbose, bool input_file, float discount) {
+bool RockSample(bool input_file, float discount, const SearchOptions &options) {
   // operator names
   const int kNorth = StringRegistry::Get()->GetInt("north");
   const int kSouth = StringRegistry::Get()->GetInt("south");
@@ -191,7 +191,7 @@ bool RockSample(bool verbose, bool input_file, float discount) {
   unique_ptr<Operator> no_op(new NoOperator(kNoop, 1.f, 1.f, log_cost));
   const vector<const ::Operator*> operators = {north_op.get(), south_op.get(), east_op.get(), west_op.get(), sample_op.get(), check_op.get(), no_op.get()};
 
-  return Search(move(start_state), goal_set, operators, env, HZero(), verbose);
+  return Search(move(start_state), goal_set, operators, env, HZero(), options);
 }
 
 } // namespace rocksample
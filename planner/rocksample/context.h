@@ -17,9 +17,11 @@
 #ifndef ROCKSAMPLE_CONTEXT_H
 #define ROCKSAMPLE_CONTEXT_H
 
+#include "search_options.h"
+
 namespace rocksample {
 
-bool RockSample(bool verbose, bool input_file, float discount);
+bool RockSample(bool input_file, float discount, const SearchOptions &options);
 
 } // namespace rocksample
 
@@ -15,6 +15,7 @@
  */
 
 #include "environment.h"
+#include "string_registry.h"
 
 namespace rocksample {
 
@@ -54,4 +55,22 @@ int Environment::GetRock(int x, int y) const {
   return -1;
 }
 
+void Environment::GetParameters(vector<int> *parameters) const {
+  parameters->push_back(num_locs_);
+  parameters->push_back(num_rocks_);
+  parameters->insert(parameters->end(), rock_locs_.begin(), rock_locs_.end());
+}
+
+void Environment::GetIrrelevantFluents(const State &start_state, const vector<const State*> &goal_set, vector<Fluent> *fluents) const {
+  const int kSampled = StringRegistry::Get()->GetInt("sampled");
+  const int kBRockGood = StringRegistry::Get()->GetInt("rock_good");
+
+  // nothing unsamples a rock
+  for (int rock = 0; rock < num_rocks_; ++rock) {
+    if (start_state.GetProb(Fluent(kSampled, {}, rock)) > 0.f) {
+      fluents->push_back(Fluent(kBRockGood, {}, rock));
+    }
+  }
+}
+
 } // namespace rocksample
@@ -39,6 +39,12 @@ class Environment : public ::Environment {
 
   int GetRock(int x, int y) const;
 
+  void GetParameters(std::vector<int> *parameters) const override;
+
+  // rocks already sampled are never checked or sampled again, so whether
+  // they are good does not matter
+  void GetIrrelevantFluents(const State &start_state, const std::vector<const State*> &goal_set, std::vector<Fluent> *fluents) const override;
+
  private:
   const int num_locs_;
   const int num_rocks_;
@@ -31,18 +31,13 @@ using namespace std;
 NorthOperator::NorthOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void NorthOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kNorth = StringRegistry::Get()->GetInt("north");
-  const int kY = StringRegistry::Get()->GetInt("y");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     // not already at the top of the map
-    if (state.GetProb(Fluent(kY, {}, 0)) == 0.f) {
+    if (state.GetProb(Fluent(y_, {}, 0)) == 0.f) {
       int robot_y = -1;
       // find current robot y
       for (int y = 1; y < env.GetNumLocs(); y++) {
-        if (state.GetProb(Fluent(kY, {}, y)) == 1.f) {
+        if (state.GetProb(Fluent(y_, {}, y)) == 1.f) {
           robot_y = y;
           break;
         }
@@ -50,14 +45,14 @@ void NorthOperator::ApplicableActions(const State &state, const Environment &env
       assert(robot_y >= 0);
 
       if (prob_ > 0.f) {
-        const vector<Fluent> preconditions{};
-        const vector<Fluent> add_list{Fluent(kY, {}, robot_y - 1, 1.f),
-                                      Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-        const vector<Fluent> delete_list{Fluent(kY, {}, robot_y, 1.f),
-                                         Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-        actions->emplace_back(new Action(kNorth, 10.f + Cost(prob_), add_list, delete_list, {}));
+        const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f)};
+        const vector<Fluent> add_list{Fluent(y_, {}, robot_y - 1, 1.f),
+                                      Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+        const vector<Fluent> delete_list{Fluent(y_, {}, robot_y, 1.f),
+                                         Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+        actions->emplace_back(new Action(name_, 10.f + Cost(prob_), preconditions, add_list, delete_list, {}));
       }
-      Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+      Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
     }
   }
 }
@@ -67,18 +62,13 @@ void NorthOperator::ApplicableActions(const State &state, const Environment &env
 SouthOperator::SouthOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void SouthOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kSouth = StringRegistry::Get()->GetInt("south");
-  const int kY = StringRegistry::Get()->GetInt("y");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     // not already at the bottom of the map
-    if (state.GetProb(Fluent(kY, {}, env.GetNumLocs() - 1)) == 0.f) {
+    if (state.GetProb(Fluent(y_, {}, env.GetNumLocs() - 1)) == 0.f) {
       int robot_y = -1;
       // find current robot y
       for (int y = 0; y < env.GetNumLocs() - 1; y++) {
-        if (state.GetProb(Fluent(kY, {}, y)) == 1.f) {
+        if (state.GetProb(Fluent(y_, {}, y)) == 1.f) {
           robot_y = y;
           break;
         }
@@ -86,14 +76,14 @@ void SouthOperator::ApplicableActions(const State &state, const Environment &env
       assert(robot_y >= 0);
 
       if (prob_ > 0.f) {
-        const vector<Fluent> preconditions{};
-        const vector<Fluent> add_list{Fluent(kY, {}, robot_y + 1, 1.f),
-                                      Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-        const vector<Fluent> delete_list{Fluent(kY, {}, robot_y, 1.f),
-                                         Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-        actions->emplace_back(new Action(kSouth, 10.f + Cost(prob_), add_list, delete_list, {}));
+        const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f)};
+        const vector<Fluent> add_list{Fluent(y_, {}, robot_y + 1, 1.f),
+                                      Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+        const vector<Fluent> delete_list{Fluent(y_, {}, robot_y, 1.f),
+                                         Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+        actions->emplace_back(new Action(name_, 10.f + Cost(prob_), preconditions, add_list, delete_list, {}));
       }
-      Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+      Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
     }
   }
 }
@@ -103,18 +93,13 @@ void SouthOperator::ApplicableActions(const State &state, const Environment &env
 EastOperator::EastOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void EastOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kEast = StringRegistry::Get()->GetInt("east");
-  const int kX = StringRegistry::Get()->GetInt("x");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     // not already one spot past the right of the map
-    if (state.GetProb(Fluent(kX, {}, env.GetNumLocs())) == 0.f) {
+    if (state.GetProb(Fluent(x_, {}, env.GetNumLocs())) == 0.f) {
       int robot_x = -1;
       // find current robot x
       for (int x = 0; x < env.GetNumLocs(); x++) {
-        if (state.GetProb(Fluent(kX, {}, x)) == 1.f) {
+        if (state.GetProb(Fluent(x_, {}, x)) == 1.f) {
           robot_x = x;
           break;
         }
@@ -124,23 +109,23 @@ void EastOperator::ApplicableActions(const State &state, const Environment &env,
       if (prob_ > 0.f) {
         // moving off east edge of map
         if ((robot_x + 1) == env.GetNumLocs()) {
-          const vector<Fluent> preconditions{};
-          const vector<Fluent> add_list{Fluent(kX, {}, robot_x + 1, 1.f),
-                                        Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1),
-                                        Fluent(kTerminated, {}, 0, 1.f)};
-          const vector<Fluent> delete_list{Fluent(kX, {}, robot_x, 1.f),
-                                           Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0))),
-                                           Fluent(kTerminated, {}, 0, 0.f)};
-          actions->emplace_back(new Action(kEast, Cost(prob_), add_list, delete_list, {}));
+          const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f)};
+          const vector<Fluent> add_list{Fluent(x_, {}, robot_x + 1, 1.f),
+                                        Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1),
+                                        Fluent(terminated_, {}, 0, 1.f)};
+          const vector<Fluent> delete_list{Fluent(x_, {}, robot_x, 1.f),
+                                           Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0))),
+                                           Fluent(terminated_, {}, 0, 0.f)};
+          actions->emplace_back(new Action(name_, Cost(prob_), preconditions, add_list, delete_list, {}));
         } else {
-          const vector<Fluent> preconditions{};
-          const vector<Fluent> add_list{Fluent(kX, {}, robot_x + 1, 1.f),
-                                        Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-          const vector<Fluent> delete_list{Fluent(kX, {}, robot_x, 1.f),
-                                           Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-          actions->emplace_back(new Action(kEast, 10.f + Cost(prob_), add_list, delete_list, {}));
-
-          Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+          const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f)};
+          const vector<Fluent> add_list{Fluent(x_, {}, robot_x + 1, 1.f),
+                                        Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+          const vector<Fluent> delete_list{Fluent(x_, {}, robot_x, 1.f),
+                                           Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+          actions->emplace_back(new Action(name_, 10.f + Cost(prob_), preconditions, add_list, delete_list, {}));
+
+          Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
         }
       }
     }
@@ -152,18 +137,13 @@ void EastOperator::ApplicableActions(const State &state, const Environment &env,
 WestOperator::WestOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void WestOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kWest = StringRegistry::Get()->GetInt("west");
-  const int kX = StringRegistry::Get()->GetInt("x");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     // not already at the left of the map
-    if (state.GetProb(Fluent(kX, {}, 0)) == 0.f) {
+    if (state.GetProb(Fluent(x_, {}, 0)) == 0.f) {
       int robot_x = -1;
       // find current robot x
       for (int x = 1; x < env.GetNumLocs() + 1; x++) {
-        if (state.GetProb(Fluent(kX, {}, x)) == 1.f) {
+        if (state.GetProb(Fluent(x_, {}, x)) == 1.f) {
           robot_x = x;
           break;
         }
@@ -172,14 +152,14 @@ void WestOperator::ApplicableActions(const State &state, const Environment &env,
 
 
       if (prob_ > 0.f) {
-        const vector<Fluent> preconditions{};
-        const vector<Fluent> add_list{Fluent(kX, {}, robot_x - 1, 1.f),
-                                      Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-        const vector<Fluent> delete_list{Fluent(kX, {}, robot_x, 1.f),
-                                         Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-        actions->emplace_back(new Action(kWest, 10.f + Cost(prob_), add_list, delete_list, {}));
+        const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f)};
+        const vector<Fluent> add_list{Fluent(x_, {}, robot_x - 1, 1.f),
+                                      Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+        const vector<Fluent> delete_list{Fluent(x_, {}, robot_x, 1.f),
+                                         Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+        actions->emplace_back(new Action(name_, 10.f + Cost(prob_), preconditions, add_list, delete_list, {}));
       }
-      Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+      Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
     }
   }
 }
@@ -189,27 +169,19 @@ void WestOperator::ApplicableActions(const State &state, const Environment &env,
 SampleOperator::SampleOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void SampleOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kSample = StringRegistry::Get()->GetInt("sample");
-  const int kSampled = StringRegistry::Get()->GetInt("sampled");
-  const int kX = StringRegistry::Get()->GetInt("x");
-  const int kY = StringRegistry::Get()->GetInt("y");
-  const int kBRockGood = StringRegistry::Get()->GetInt("rock_good");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     int robot_x = -1;
     int robot_y = -1;
     // find current robot x
     for (int x = 0; x < env.GetNumLocs() + 1; x++) {
-      if (state.GetProb(Fluent(kX, {}, x)) == 1.f) {
+      if (state.GetProb(Fluent(x_, {}, x)) == 1.f) {
         robot_x = x;
         break;
       }
     }
     // find current robot y
     for (int y = 0; y < env.GetNumLocs() + 1; y++) {
-      if (state.GetProb(Fluent(kY, {}, y)) == 1.f) {
+      if (state.GetProb(Fluent(y_, {}, y)) == 1.f) {
         robot_y = y;
         break;
       }
@@ -222,16 +194,20 @@ void SampleOperator::ApplicableActions(const State &state, const Environment &en
     if (prob_ > 0.f) {
       int rock = env.GetRock(robot_x, robot_y);
       // there is a rock at robot location we haven't already sampled
-      if (rock != -1 && state.GetProb(Fluent(kSampled, {}, rock)) == 0.f) {
-        const vector<Fluent> add_list{Fluent(kSampled, {}, rock, 1.f),
-                                      Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-        const vector<Fluent> delete_list{Fluent(kSampled, {}, rock, 0.f),
-                                         Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-        float sample_cost = 20.f * (1.f - state.GetProb(Fluent(kBRockGood, {}, rock)));
-        actions->emplace_back(new Action(kSample, sample_cost + Cost(prob_), add_list, delete_list, {}));
+      if (rock != -1 && state.GetProb(Fluent(sampled_, {}, rock)) == 0.f) {
+        const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f),
+                                           Fluent(x_, {}, robot_x, 1.f),
+                                           Fluent(y_, {}, robot_y, 1.f),
+                                           Fluent(rock_good_, {}, rock, state.GetProb(Fluent(rock_good_, {}, rock)))};
+        const vector<Fluent> add_list{Fluent(sampled_, {}, rock, 1.f),
+                                      Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+        const vector<Fluent> delete_list{Fluent(sampled_, {}, rock, 0.f),
+                                         Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+        float sample_cost = 20.f * (1.f - state.GetProb(Fluent(rock_good_, {}, rock)));
+        actions->emplace_back(new Action(name_, sample_cost + Cost(prob_), preconditions, add_list, delete_list, {}));
       }
     }
-    Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+    Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
   }
 }
 
@@ -240,27 +216,19 @@ void SampleOperator::ApplicableActions(const State &state, const Environment &en
 CheckOperator::CheckOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 0.f, cost_multiplier, log_cost) {}
 
 void CheckOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kCheck = StringRegistry::Get()->GetInt("check");
-  const int kX = StringRegistry::Get()->GetInt("x");
-  const int kY = StringRegistry::Get()->GetInt("y");
-  const int kBRockGood = StringRegistry::Get()->GetInt("rock_good");
-  const int kSampled = StringRegistry::Get()->GetInt("sampled");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) == 0.f) {
+  if (state.GetProb(Fluent(terminated_, {}, 0)) == 0.f) {
     int robot_x = -1;
     int robot_y = -1;
     // find current robot x
     for (int x = 0; x < env.GetNumLocs() + 1; x++) {
-      if (state.GetProb(Fluent(kX, {}, x)) == 1.f) {
+      if (state.GetProb(Fluent(x_, {}, x)) == 1.f) {
         robot_x = x;
         break;
       }
     }
     // find current robot y
     for (int y = 0; y < env.GetNumLocs() + 1; y++) {
-      if (state.GetProb(Fluent(kY, {}, y)) == 1.f) {
+      if (state.GetProb(Fluent(y_, {}, y)) == 1.f) {
         robot_y = y;
         break;
       }
@@ -270,14 +238,18 @@ void CheckOperator::ApplicableActions(const State &state, const Environment &env
     if (prob_ > 0.f) {
       for (int rock = 0; rock < env.GetNumRocks(); ++rock) {
         // only check rocks we have not already sampled
-        if (state.GetProb(Fluent(kSampled, {}, rock)) == 0.f) {
+        if (state.GetProb(Fluent(sampled_, {}, rock)) == 0.f) {
           int rock_x = env.GetRockX(rock);
           int rock_y = env.GetRockY(rock);
           float d = std::sqrt(std::pow(robot_x - rock_x, 2) + std::pow(robot_y - rock_y, 2));
           float efficiency = std::exp(-d);
           float sensor_accuracy = 0.5f + 0.5f * efficiency;
-          float rock_good_p = state.GetProb(Fluent(kBRockGood, {}, rock));
+          float rock_good_p = state.GetProb(Fluent(rock_good_, {}, rock));
           assert(!isnan(rock_good_p));
+          const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, 0.f),
+                                             Fluent(x_, {}, robot_x, 1.f),
+                                             Fluent(y_, {}, robot_y, 1.f),
+                                             Fluent(sampled_, {}, rock, 0.f)};
 
           // P(obs rock is good) = P(rock is good) * P(sensor is right) + (1 - P(rock is good)) * (1 - P(sensor is right))
           float obs_rock_good_p = rock_good_p * sensor_accuracy + (1.f - rock_good_p) * (1.f - sensor_accuracy);
@@ -291,11 +263,11 @@ void CheckOperator::ApplicableActions(const State &state, const Environment &env
             assert(!isnan(rock_good_obs_good));
 
             // observe rock is good
-            const vector<Fluent> add_list_good{Fluent(kBRockGood, {}, rock, rock_good_obs_good),
-                                               Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-            const vector<Fluent> delete_list_good{Fluent(kBRockGood, {}, rock, rock_good_p),
-                                                  Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-            actions->emplace_back(new Action(kCheck, 10.f + Cost(obs_rock_good_p * prob_) , add_list_good, delete_list_good, {rock}));
+            const vector<Fluent> add_list_good{Fluent(rock_good_, {}, rock, rock_good_obs_good),
+                                               Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+            const vector<Fluent> delete_list_good{Fluent(rock_good_, {}, rock, rock_good_p),
+                                                  Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+            actions->emplace_back(new Action(name_, 10.f + Cost(obs_rock_good_p * prob_) , preconditions, add_list_good, delete_list_good, {rock}));
           }
 
           if (obs_rock_bad_p > 0.f) {
@@ -304,16 +276,16 @@ void CheckOperator::ApplicableActions(const State &state, const Environment &env
             assert(!isnan(rock_good_obs_bad));
 
             // observe rock is bad
-            const vector<Fluent> add_list_bad{Fluent(kBRockGood, {}, rock, rock_good_obs_bad),
-                                              Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-            const vector<Fluent> delete_list_bad{Fluent(kBRockGood, {}, rock, rock_good_p),
-                                                 Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-            actions->emplace_back(new Action(kCheck, 10.f + Cost(obs_rock_bad_p * prob_) , add_list_bad, delete_list_bad, {rock}));
+            const vector<Fluent> add_list_bad{Fluent(rock_good_, {}, rock, rock_good_obs_bad),
+                                              Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+            const vector<Fluent> delete_list_bad{Fluent(rock_good_, {}, rock, rock_good_p),
+                                                 Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+            actions->emplace_back(new Action(name_, 10.f + Cost(obs_rock_bad_p * prob_) , preconditions, add_list_bad, delete_list_bad, {rock}));
           }
         }
       }
     }
-    Terminate(1.f - prob_, state.GetProb(Fluent(kSteps, {}, 0)), actions);
+    Terminate(1.f - prob_, state.GetProb(Fluent(steps_, {}, 0)), actions);
   }
 }
 
@@ -322,14 +294,11 @@ void CheckOperator::ApplicableActions(const State &state, const Environment &env
 NoOperator::NoOperator(int name, float prob, float cost_multiplier, bool log_cost) : Operator(name, prob, 1.f, 10.f, cost_multiplier, log_cost) {}
 
 void NoOperator::ApplicableActions(const State &state, const Environment &env, vector<unique_ptr<Action>> *actions) const {
-  const int kNoop = StringRegistry::Get()->GetInt("noop");
-  const int kSteps = StringRegistry::Get()->GetInt("steps");
-  const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-
-  if (state.GetProb(Fluent(kTerminated, {}, 0)) > 0.f) {
-    const vector<Fluent> add_list{Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)) + 1)};
-    const vector<Fluent> delete_list{Fluent(kSteps, {}, 0, state.GetProb(Fluent(kSteps, {}, 0)))};
-    actions->emplace_back(new Action(kNoop, Cost(prob_), add_list, delete_list, {}));
+  if (state.GetProb(Fluent(terminated_, {}, 0)) > 0.f) {
+    const vector<Fluent> preconditions{Fluent(terminated_, {}, 0, state.GetProb(Fluent(terminated_, {}, 0)))};
+    const vector<Fluent> add_list{Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)) + 1)};
+    const vector<Fluent> delete_list{Fluent(steps_, {}, 0, state.GetProb(Fluent(steps_, {}, 0)))};
+    actions->emplace_back(new Action(name_, Cost(prob_), preconditions, add_list, delete_list, {}));
   }
 }
 
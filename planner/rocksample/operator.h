@@ -40,17 +40,23 @@ class Operator : public ::Operator {
   virtual void ApplicableActions(const State &state, const Environment &env, std::vector<std::unique_ptr<Action>> *actions) const = 0;
 
  protected:
+  // registry ids of the predicates and of the terminate action, looked up
+  // once when the operator is built
+  const int x_ = StringRegistry::Get()->GetInt("x");
+  const int y_ = StringRegistry::Get()->GetInt("y");
+  const int steps_ = StringRegistry::Get()->GetInt("steps");
+  const int terminated_ = StringRegistry::Get()->GetInt("terminated");
+  const int sampled_ = StringRegistry::Get()->GetInt("sampled");
+  const int rock_good_ = StringRegistry::Get()->GetInt("rock_good");
+  const int terminate_ = StringRegistry::Get()->GetInt("terminate");
+
   void Terminate(float terminate_p, float steps, std::vector<std::unique_ptr<Action>> *actions) const {
     if (terminate_p > 0.f) {
-      const int kTerminate = StringRegistry::Get()->GetInt("terminate");
-      const int kTerminated = StringRegistry::Get()->GetInt("terminated");
-      const int kSteps = StringRegistry::Get()->GetInt("steps");
-
       const std::vector<Fluent> preconditions{};
-      const std::vector<Fluent> add_list{Fluent(kTerminated, {}, 0, 1.f),
-                                         Fluent(kSteps, {}, 0, steps + 1)};
-      const std::vector<Fluent> delete_list{Fluent(kSteps, {}, 0, steps)};
-      actions->emplace_back(new Action(kTerminate, Cost(terminate_p), add_list, delete_list, {}));
+      const std::vector<Fluent> add_list{Fluent(terminated_, {}, 0, 1.f),
+                                         Fluent(steps_, {}, 0, steps + 1)};
+      const std::vector<Fluent> delete_list{Fluent(steps_, {}, 0, steps)};
+      actions->emplace_back(new Action(terminate_, Cost(terminate_p), preconditions, add_list, delete_list, {}));
     }
   }
 };
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SEARCH_OPTIONS_H
+#define SEARCH_OPTIONS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+class LearnedTable;
+class Symmetry;
+
+// Settings that select and tune the search, filled in from the command line
+// in main and passed through the problem contexts to Search.
+struct SearchOptions {
+  SearchOptions() : verbose(false), quiet(false), weight(0.f), epsilon(0.f), reopen(false), anytime(false), anytime_step(0.05f), greedy(false), preferred(false), preferred_boost(1000), deferred(false), hill_climbing(false), ida(false), ida_table_size(0), beam_width(0), beam_depth(1000), beam_restarts(0), width(2), width_heuristic(false), lrta_lookahead(0), lrta_steps(1), learned_table(nullptr), max_nodes(0), max_memory_mb(0), threads(1), eval_threads(1), batch_size(1), relevance(false), relevance_max_states(1000), partial_order(false), dominance(false), symmetry_reduction(false), macro_looks(false), cancelled(nullptr), deadline(std::chrono::steady_clock::time_point::max()), symmetry(nullptr), open_list("heap"), bucket_width(0.01f), pdb_buckets(10), pdb_max_states(1000000) {}
+
+  bool verbose;
+  bool quiet; // no progress lines, for searches running side by side
+  float weight; // 0.0 = greediest
+  float epsilon;
+  bool reopen; // expand states again when a cheaper path to them is found
+  bool anytime; // improve the plan while raising the weight (see anytime_search.h)
+  float anytime_step; // weight added after each anytime round
+  bool greedy; // greedy best-first search on the heuristic cost (see greedy_search.h)
+  bool preferred; // second open list for children reached by helpful actions
+  int preferred_boost; // extra turns of the preferred open list on progress
+  bool deferred; // evaluate nodes when expanded rather than when generated
+  bool hill_climbing; // enforced hill-climbing (see hill_climbing.h)
+  bool ida; // iterative deepening on the weighted cost (see ida_search.h)
+  int ida_table_size; // states remembered per IDA* iteration, 0 for none
+  int beam_width; // beam search (see beam_search.h) if positive
+  int beam_depth; // layers searched before a beam search fails
+  int beam_restarts; // beam searches again with twice the width after failing
+  std::string width_search; // "iw" or "bfws" (see width_search.h)
+  int width; // largest tuples of atoms whose novelty is measured, 1 or 2
+  bool width_heuristic; // break ties in BFWS on the heuristic cost
+  int lrta_lookahead; // real-time search (see realtime_search.h) expanding this many nodes per step, if positive
+  int lrta_steps; // steps taken by the real-time search, 0 for as many as it takes to reach a goal
+  std::string lrta_table; // learned costs of the real-time search are loaded from and saved to this file
+  LearnedTable *learned_table; // learned costs kept in memory across the problems of a resident planner, if set
+  int max_nodes; // bound on nodes kept in memory, 0 for none
+  int max_memory_mb; // bound on memory taken by nodes, 0 for none
+  int threads; // hash distributed search (see hda_search.h) if more than 1
+  int eval_threads; // threads evaluating the children of an expansion (see eval_pool.h)
+  int batch_size; // best nodes popped and expanded together, on the eval_threads
+  bool relevance; // prune irrelevant actions and fluents first (see relevance.h)
+  int relevance_max_states; // real states the relevance analysis grounds before keeping everything
+  bool partial_order; // apply commuting actions in one order only, with sleep sets (see Action::Interferes)
+  bool dominance; // drop children dominated by a queued state (see dominance.h)
+  bool symmetry_reduction; // search canonical states of interchangeable objects (see symmetry.h)
+  bool macro_looks; // kitchen: also look repeatedly until a goal probability is reached
+  std::string portfolio; // configurations to run side by side (see portfolio.h)
+  const std::atomic<bool> *cancelled; // the search gives up once it is true, if set
+  std::chrono::steady_clock::time_point deadline; // the search gives up after it
+  const Symmetry *symmetry; // UCSearch turns new states into canonical ones, if set
+  std::string open_list; // "heap" or "bucket" (see open_list.h), unused if epsilon > 0
+  float bucket_width; // weighted cost resolution of the bucket open list
+
+  // pattern databases (see pdb.h)
+  std::string pdb_file; // load tables from this file and use them as the heuristic
+  std::string pdb_build_file; // build tables for the problem, write them here and exit
+  std::string pdb_patterns; // ';'-separated patterns of ','-separated predicates
+  int pdb_buckets; // probability buckets per fluent in the abstract states
+  int pdb_max_states; // cap on abstract states enumerated per pattern
+
+  // true once the search was cancelled or ran past its deadline
+  bool Interrupted() const {
+    return (cancelled != nullptr && *cancelled) || std::chrono::steady_clock::now() >= deadline;
+  }
+};
+
+#endif  // SEARCH_OPTIONS_H
@@ -20,13 +20,39 @@ std::unique_ptr<StringRegistry> StringRegistry::singleton_;
 
 void StringRegistry::Init() { singleton_.reset(new StringRegistry); }
 
+StringRegistry::StringRegistry() {
+  snapshots_.emplace_back(new Snapshot());
+  snapshot_.store(snapshots_.back().get(), std::memory_order_release);
+}
+
 int StringRegistry::GetInt(const std::string& str) {
-  const Map::const_iterator iter = map_.find(str);
-  if (iter != map_.end()) {
+  const Snapshot *snapshot = snapshot_.load(std::memory_order_acquire);
+  Map::const_iterator iter = snapshot->map.find(str);
+  if (iter != snapshot->map.end()) {
+    return iter->second;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // another thread may have added str since
+  snapshot = snapshot_.load(std::memory_order_acquire);
+  iter = snapshot->map.find(str);
+  if (iter != snapshot->map.end()) {
     return iter->second;
   }
-  const int result = table_.size();
-  // Store a pointer to the newly inserted element in the map.
-  table_.push_back(&map_.insert(iter, Map::value_type(str, result))->first);
+  std::unique_ptr<Snapshot> next(new Snapshot());
+  next->map = snapshot->map;
+  next->map.insert(Map::value_type(str, snapshot->table.size()));
+  // table points into the snapshot's own map
+  next->table.resize(next->map.size());
+  for (const Map::value_type &entry : next->map) {
+    next->table[entry.second] = &entry.first;
+  }
+  const int result = snapshot->table.size();
+  snapshots_.emplace_back(next.release());
+  snapshot_.store(snapshots_.back().get(), std::memory_order_release);
   return result;
 }
+
+const std::string &StringRegistry::GetString(const int str_int) const {
+  return *snapshot_.load(std::memory_order_acquire)->table[str_int];
+}
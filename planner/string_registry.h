@@ -17,8 +17,10 @@
 #ifndef STRING_REGISTRY_H
 #define STRING_REGISTRY_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -32,17 +34,31 @@ class StringRegistry {
   static StringRegistry* Get() { return singleton_.get(); }
 
   // Retrieve the integer mapping for a string. Adds the string to the
-  // registry if not previously added.
+  // registry if not previously added. Safe to call from several threads;
+  // only adding a string takes a lock.
   int GetInt(const std::string& str);
 
-  // Returns the string for a previously added mapping.
-  const std::string &GetString(const int str_int) const { return *table_[str_int]; }
+  // Returns the string for a previously added mapping. Safe to call from
+  // several threads without a lock.
+  const std::string &GetString(const int str_int) const;
 
  private:
-  static std::unique_ptr<StringRegistry> singleton_;
   typedef std::map<std::string, int> Map;
-  Map map_;
-  std::vector<const std::string*> table_;
+
+  // immutable once published, so readers need no lock
+  struct Snapshot {
+    Map map;
+    std::vector<const std::string*> table;
+  };
+
+  StringRegistry();
+
+  static std::unique_ptr<StringRegistry> singleton_;
+  std::atomic<const Snapshot*> snapshot_;
+  std::mutex mutex_; // serializes adding strings
+  // every snapshot published, kept as readers may still hold an older one;
+  // strings are added at startup, so there are few
+  std::vector<std::unique_ptr<const Snapshot>> snapshots_;
 };
 
 #endif  // STRING_REGISTRY_H
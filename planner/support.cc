@@ -99,6 +99,10 @@ string State::GetString() const {
   return ss.str();
 }
 
+const FluentSet& State::GetFluents() const {
+  return fluents_;
+}
+
 void State::Add(const Fluent &f) {
   FluentExcludingProbSet::const_iterator iter = fluents_ex_prob_.find(f);
   // fluent does not already exist
@@ -114,9 +118,14 @@ void State::Add(const Fluent &f) {
 }
 
 void State::Remove(const Fluent &f) {
-  fluents_.erase(f);
-  hash_ ^= f.Hash();
-  fluents_ex_prob_.erase(f);
+  // the stored fluent may have another probability than f, or be absent
+  FluentExcludingProbSet::const_iterator iter = fluents_ex_prob_.find(f);
+  if (iter == fluents_ex_prob_.end()) {
+    return;
+  }
+  fluents_.erase(*iter);
+  hash_ ^= iter->Hash();
+  fluents_ex_prob_.erase(iter);
 }
 
 bool State::SatisfiedBy(const State *state) const {
@@ -159,6 +168,12 @@ Action::Action(int name, float cost, const std::vector<Fluent> &add_list,
                const std::vector<Fluent> &delete_list, const std::vector<int> &info) :
                name_(name), cost_(cost), add_list_(add_list), delete_list_(delete_list), info_(info) {}
 
+Action::Action(int name, float cost, const std::vector<Fluent> &preconditions,
+               const std::vector<Fluent> &add_list, const std::vector<Fluent> &delete_list,
+               const std::vector<int> &info) :
+               name_(name), cost_(cost), preconditions_(preconditions), add_list_(add_list),
+               delete_list_(delete_list), info_(info) {}
+
 std::string Action::GetPlanString() const {
   stringstream ss;
   ss << StringRegistry::Get()->GetString(name_);
@@ -180,6 +195,18 @@ const vector<int>& Action::GetInfo() const {
   return info_;
 }
 
+const vector<Fluent>& Action::GetPreconditions() const {
+  return preconditions_;
+}
+
+const vector<Fluent>& Action::GetAddList() const {
+  return add_list_;
+}
+
+const vector<Fluent>& Action::GetDeleteList() const {
+  return delete_list_;
+}
+
 string Action::GetString() const {
   std::ostringstream ss;
   ss << "Action{" << StringRegistry::Get()->GetString(name_) << ",\n";
@@ -206,3 +233,17 @@ void Action::AddSuccessor(State *state) const {
     state->Add(f);
   }
 }
+
+bool Action::Interferes(const Action &other) const {
+  FluentExcludingProbSet fluents(preconditions_.begin(), preconditions_.end());
+  fluents.insert(add_list_.begin(), add_list_.end());
+  fluents.insert(delete_list_.begin(), delete_list_.end());
+  for (const vector<Fluent> *list : {&other.preconditions_, &other.add_list_, &other.delete_list_}) {
+    for (const Fluent &f : *list) {
+      if (fluents.count(f) > 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
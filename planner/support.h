@@ -110,6 +110,8 @@ class State {
 
   std::string GetString() const;
 
+  const FluentSet& GetFluents() const;
+
   void Add(const Fluent &f);
 
   void Remove(const Fluent &f);
@@ -158,6 +160,12 @@ class Action {
   Action(int name, float cost, const std::vector<Fluent> &add_list,
          const std::vector<Fluent> &delete_list, const std::vector<int> &info);
 
+  // preconditions are the fluents the action was computed from that it does
+  // not change (the delete list already holds the prior values of those it does)
+  Action(int name, float cost, const std::vector<Fluent> &preconditions,
+         const std::vector<Fluent> &add_list, const std::vector<Fluent> &delete_list,
+         const std::vector<int> &info);
+
   std::string GetString() const;
 
   std::string GetPlanString() const;
@@ -168,13 +176,25 @@ class Action {
 
   const std::vector<int>& GetInfo() const;
 
+  const std::vector<Fluent>& GetPreconditions() const;
+
+  const std::vector<Fluent>& GetAddList() const;
+
+  const std::vector<Fluent>& GetDeleteList() const;
+
   void Successor(State *state) const;
 
   void AddSuccessor(State *state) const;
 
+  // true if the actions share a fluent (whatever its probability) in their
+  // preconditions, add or delete lists. Operators list every fluent an action
+  // reads in one of them, so actions that do not interfere commute.
+  bool Interferes(const Action &other) const;
+
  private:
   const int name_;
   const float cost_;
+  const std::vector<Fluent> preconditions_;
   const std::vector<Fluent> add_list_;
   const std::vector<Fluent> delete_list_;
   const std::vector<int> info_;
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "symmetry.h"
+
+using namespace std;
+
+namespace {
+
+int Find(vector<int> *parents, int i) {
+  while ((*parents)[i] != i) {
+    i = (*parents)[i] = (*parents)[(*parents)[i]];
+  }
+  return i;
+}
+
+} // namespace
+
+Symmetry::Symmetry(const State &start_state, const vector<const State*> &goal_set, const Environment &env) {
+  env.GetObjectTypes(&types_);
+  for (int t = 0; t < types_.size(); ++t) {
+    for (const ObjectType::Slot &slot : types_[t].slots) {
+      slots_[slot.predicate].emplace_back(t, slot.position);
+    }
+  }
+
+  // swaps that keep the start and goal states generate the symmetries
+  for (int t = 0; t < types_.size(); ++t) {
+    const int num_objects = types_[t].num_objects;
+    vector<int> parents(num_objects);
+    iota(parents.begin(), parents.end(), 0);
+    for (int a = 0; a < num_objects; ++a) {
+      for (int b = a + 1; b < num_objects; ++b) {
+        if (Find(&parents, a) == Find(&parents, b)) {
+          continue;
+        }
+        Permutation swap = Identity();
+        swap[t][a] = b;
+        swap[t][b] = a;
+        bool symmetric = (*Permute(start_state, swap) == start_state);
+        for (const State *goal_state : goal_set) {
+          symmetric = symmetric && (*Permute(*goal_state, swap) == *goal_state);
+        }
+        if (symmetric) {
+          parents[Find(&parents, b)] = Find(&parents, a);
+        }
+      }
+    }
+
+    unordered_map<int, vector<int>> classes;
+    for (int o = 0; o < num_objects; ++o) {
+      classes[Find(&parents, o)].push_back(o);
+    }
+    classes_.emplace_back();
+    for (int o = 0; o < num_objects; ++o) {
+      if (Find(&parents, o) == o && classes[o].size() > 1) {
+        classes_.back().push_back(classes[o]);
+      }
+    }
+  }
+}
+
+bool Symmetry::Any() const {
+  for (const vector<vector<int>> &classes : classes_) {
+    if (!classes.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+unique_ptr<State> Symmetry::Canonical(const State &state, Permutation *permutation) const {
+  unique_ptr<State> canonical(new State(state));
+  if (permutation != nullptr) {
+    *permutation = Identity();
+  }
+  for (int t = 0; t < types_.size(); ++t) {
+    if (classes_[t].empty()) {
+      continue;
+    }
+    Permutation step = Identity();
+    step[t] = SortObjects(*canonical, t);
+    canonical = Permute(*canonical, step);
+    if (permutation != nullptr) {
+      *permutation = Compose(*permutation, step);
+    }
+  }
+  return canonical;
+}
+
+unique_ptr<State> Symmetry::Permute(const State &state, const Permutation &permutation) const {
+  vector<Fluent> fluents;
+  for (const Fluent &fluent : state.GetFluents()) {
+    fluents.push_back(Permute(fluent, permutation));
+  }
+  return unique_ptr<State>(new State(fluents));
+}
+
+Symmetry::Permutation Symmetry::Compose(const Permutation &first, const Permutation &second) {
+  Permutation composed = first;
+  for (int t = 0; t < composed.size(); ++t) {
+    for (int &o : composed[t]) {
+      o = second[t][o];
+    }
+  }
+  return composed;
+}
+
+string Symmetry::GetString() const {
+  ostringstream ss;
+  ss << "symmetry:";
+  for (int t = 0; t < classes_.size(); ++t) {
+    for (const vector<int> &objects : classes_[t]) {
+      ss << " type " << t << " objects {" << Stringer(objects, " ") << "}";
+    }
+  }
+  if (!Any()) {
+    ss << " no interchangeable objects";
+  }
+  return ss.str();
+}
+
+Symmetry::Permutation Symmetry::Identity() const {
+  Permutation identity(types_.size());
+  for (int t = 0; t < types_.size(); ++t) {
+    identity[t].resize(types_[t].num_objects);
+    iota(identity[t].begin(), identity[t].end(), 0);
+  }
+  return identity;
+}
+
+Fluent Symmetry::Permute(const Fluent &fluent, const Permutation &permutation) const {
+  unordered_map<int, vector<pair<int, int>>>::const_iterator slots = slots_.find(fluent.GetPredicate());
+  if (slots == slots_.end()) {
+    return fluent;
+  }
+  vector<int> args = fluent.GetArgs();
+  int value = fluent.GetValue();
+  for (const pair<int, int> &slot : slots->second) {
+    int &object = (slot.second < 0) ? value : args[slot.second];
+    // for example no object held
+    if (object >= 0 && object < permutation[slot.first].size()) {
+      object = permutation[slot.first][object];
+    }
+  }
+  return Fluent(fluent.GetPredicate(), args, value, fluent.GetProb());
+}
+
+vector<int> Symmetry::SortObjects(const State &state, int type) const {
+  const int kObject = -2;
+
+  // hashes of the fluents every object appears in, with the object masked
+  vector<vector<size_t>> signatures(types_[type].num_objects);
+  for (const Fluent &fluent : state.GetFluents()) {
+    unordered_map<int, vector<pair<int, int>>>::const_iterator slots = slots_.find(fluent.GetPredicate());
+    if (slots == slots_.end()) {
+      continue;
+    }
+    for (const pair<int, int> &slot : slots->second) {
+      if (slot.first != type) {
+        continue;
+      }
+      vector<int> args = fluent.GetArgs();
+      int value = fluent.GetValue();
+      int &object = (slot.second < 0) ? value : args[slot.second];
+      if (object < 0 || object >= signatures.size()) {
+        continue;
+      }
+      const int o = object;
+      object = kObject;
+      signatures[o].push_back(Fluent(fluent.GetPredicate(), args, value, fluent.GetProb()).Hash());
+    }
+  }
+  for (vector<size_t> &signature : signatures) {
+    sort(signature.begin(), signature.end());
+  }
+
+  vector<int> relabeling(types_[type].num_objects);
+  iota(relabeling.begin(), relabeling.end(), 0);
+  for (const vector<int> &objects : classes_[type]) {
+    vector<int> sorted = objects;
+    stable_sort(sorted.begin(), sorted.end(), [&signatures](int a, int b) {
+      return signatures[a] < signatures[b];
+    });
+    for (int k = 0; k < objects.size(); ++k) {
+      relabeling[sorted[k]] = objects[k];
+    }
+  }
+  return relabeling;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "environment.h"
+#include "support.h"
+
+// Interchangeable objects of a problem. Two objects of a type (see
+// Environment::GetObjectTypes) are interchangeable if swapping them leaves the
+// start state and every goal state unchanged, and the operators then treat
+// them alike. Relabeling interchangeable objects maps states to symmetric
+// ones, reached by the same plans up to the relabeling and at the same cost.
+class Symmetry {
+ public:
+  // object o of type t is relabeled as [t][o]
+  typedef std::vector<std::vector<int>> Permutation;
+
+  Symmetry(const State &start_state, const std::vector<const State*> &goal_set, const Environment &env);
+
+  // true if some objects are interchangeable
+  bool Any() const;
+
+  // state with the objects of each set of interchangeable objects relabeled
+  // in the order of the fluents they appear in. Symmetric states mostly get
+  // the same canonical state. The relabeling is returned in permutation if it
+  // is not nullptr.
+  std::unique_ptr<State> Canonical(const State &state, Permutation *permutation) const;
+
+  std::unique_ptr<State> Permute(const State &state, const Permutation &permutation) const;
+
+  // second applied after first
+  static Permutation Compose(const Permutation &first, const Permutation &second);
+
+  std::string GetString() const;
+
+ private:
+  Permutation Identity() const;
+
+  Fluent Permute(const Fluent &fluent, const Permutation &permutation) const;
+
+  // relabeling of the objects of type that sorts each set by the fluents
+  // the objects appear in
+  std::vector<int> SortObjects(const State &state, int type) const;
+
+  std::vector<ObjectType> types_;
+  // sets of at least two interchangeable objects, for every type
+  std::vector<std::vector<std::vector<int>>> classes_;
+  // (type, position) of the object slots of every predicate
+  std::unordered_map<int, std::vector<std::pair<int, int>>> slots_;
+};
+
+#endif  // SYMMETRY_H
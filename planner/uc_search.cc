@@ -16,17 +16,437 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
-#include <queue>
+#include <limits>
+#include <set>
 #include <sstream>
 #include <unordered_map>
-
+#include <unordered_set>
+
+#include "anytime_search.h"
+#include "beam_search.h"
+#include "dominance.h"
+#include "eval_pool.h"
+#include "greedy_search.h"
+#include "hda_search.h"
+#include "hill_climbing.h"
+#include "ida_search.h"
+#include "open_list.h"
+#include "pdb.h"
+#include "portfolio.h"
+#include "realtime_search.h"
+#include "relevance.h"
 #include "string_registry.h"
+#include "symmetry.h"
 #include "uc_search.h"
+#include "width_search.h"
 
 using namespace std;
 
-SearchNode::SearchNode(std::unique_ptr<const State> state, const SearchNode *parent, std::unique_ptr<const Action> action, float heuristic_cost, int count, float weight) : state_(move(state)), parent_(parent), action_(move(action)), heuristic_cost_(heuristic_cost), hmax_(-1.f), count_(count), weight_(weight) {
+namespace {
+
+typedef unordered_map<const State*, const SearchNode*, StatePtrHash, StatePtrEqual> BestNodes;
+
+// StateKeys of the expanded states whose nodes were freed by PruneNodes
+typedef unordered_set<uint64_t> ClosedKeys;
+
+// a State keeps every fluent in two hash sets, and the args of a fluent have
+// their own allocation
+const size_t kFluentBytes = sizeof(Fluent) + 2 * sizeof(void*) + 2 * sizeof(int);
+
+size_t ApproximateStateBytes(const State &state) {
+  return sizeof(State) + 2 * state.GetFluents().size() * kFluentBytes;
+}
+
+// an entry of ClosedKeys with its share of the buckets
+const size_t kClosedKeyBytes = sizeof(uint64_t) + 2 * sizeof(void*);
+
+// true if state is expanded or its node was freed after being expanded
+bool Closed(const State &state, const StateSet &expanded, const ClosedKeys &closed_keys) {
+  return expanded.count(&state) > 0 || (!closed_keys.empty() && closed_keys.count(StateKey(state)) > 0);
+}
+
+// true if num_nodes or bytes is past fraction of the bounds in options
+bool OverBound(const SearchOptions &options, size_t num_nodes, size_t bytes, float fraction) {
+  return (options.max_nodes > 0 && num_nodes > options.max_nodes * fraction) ||
+         (options.max_memory_mb > 0 && bytes > options.max_memory_mb * fraction * (1 << 20));
+}
+
+// Frees nodes to bring the search back to 3/4 of its memory bound, as in SMA*.
+// The cheapest queued nodes are kept along with their ancestors (for the
+// path), and the other queued nodes are forgotten. The parent of a forgotten
+// node is queued again, with its weighted cost raised to the lowest one of its
+// forgotten children, so that it generates them again once they are the most
+// promising. Expanded nodes that are not ancestors of a queued node or of keep
+// are freed, and the StateKey of their state goes to closed_keys, so that the
+// state is still not expanded again.
+void PruneNodes(const SearchOptions &options, const SearchNode *keep, vector<unique_ptr<SearchNode>> *visited, OpenList *agenda, StateSet *expanded, BestNodes *best_nodes, ClosedKeys *closed_keys, size_t *node_bytes, size_t *closed_bytes) {
+  vector<const SearchNode*> queued;
+  agenda->Release(&queued);
+  // superseded nodes would be skipped anyway
+  queued.erase(remove_if(queued.begin(), queued.end(), [best_nodes](const SearchNode *node) {
+    BestNodes::const_iterator best = best_nodes->find(node->GetState());
+    return best == best_nodes->end() || best->second != node;
+  }), queued.end());
+  sort(queued.begin(), queued.end(), [](const SearchNode *lhs, const SearchNode *rhs) {
+    return make_pair(lhs->GetWeightedCost(), lhs->GetCount()) < make_pair(rhs->GetWeightedCost(), rhs->GetCount());
+  });
+
+  unordered_set<const SearchNode*> live;
+  size_t live_bytes = *closed_bytes;
+  function<void(const SearchNode*)> keep_path = [&](const SearchNode *node) {
+    for (const SearchNode *n = node; n != nullptr && live.insert(n).second; n = n->GetParent()) {
+      live_bytes += n->GetApproximateBytes();
+    }
+  };
+  keep_path(keep);
+  unordered_set<const SearchNode*> requeue;
+  vector<const SearchNode*> forgotten;
+  for (const SearchNode *node : queued) {
+    // the initial node, queued again, has no parent to generate it
+    if (!requeue.empty() && node->GetParent() != nullptr && OverBound(options, live.size(), live_bytes, 0.75f)) {
+      forgotten.push_back(node);
+      continue;
+    }
+    keep_path(node);
+    requeue.insert(node);
+  }
+
+  // lowest weighted cost of the forgotten children of the nodes queued again
+  // to generate them, taken by the best node of the parent's state
+  unordered_map<const SearchNode*, float> backed_up;
+  for (const SearchNode *node : forgotten) {
+    BestNodes::const_iterator best = best_nodes->find(node->GetParent()->GetState());
+    const SearchNode *parent = (best != best_nodes->end()) ? best->second : node->GetParent();
+    unordered_map<const SearchNode*, float>::iterator iter = backed_up.find(parent);
+    if (iter == backed_up.end()) {
+      backed_up[parent] = node->GetWeightedCost();
+    } else {
+      iter->second = min(iter->second, node->GetWeightedCost());
+    }
+  }
+  for (const pair<const SearchNode* const, float> &entry : backed_up) {
+    keep_path(entry.first);
+  }
+  // a forgotten node that is the parent of a node queued again stays queued
+  for (const SearchNode *node : forgotten) {
+    if (live.count(node) > 0) {
+      requeue.insert(node);
+    }
+  }
+
+  vector<const SearchNode*> reopened;
+  int num_freed = 0;
+  for (unique_ptr<SearchNode> &node : *visited) {
+    const State *state = node->GetState();
+    if (live.count(node.get()) > 0) {
+      unordered_map<const SearchNode*, float>::const_iterator iter = backed_up.find(node.get());
+      if (iter == backed_up.end()) {
+        continue;
+      }
+      if (requeue.count(node.get()) > 0) {
+        // already queued again for earlier forgotten children
+        node->SetBackedUpCost(min(node->GetWeightedCost(), iter->second));
+      } else {
+        // expanded, open it again for the forgotten children
+        expanded->erase(state);
+        node->SetBackedUpCost(iter->second);
+        reopened.push_back(node.get());
+      }
+      continue;
+    }
+    BestNodes::iterator best = best_nodes->find(state);
+    if (best != best_nodes->end() && best->second == node.get()) {
+      best_nodes->erase(best);
+    }
+    StateSet::iterator closed = expanded->find(state);
+    if (closed != expanded->end() && *closed == state) {
+      expanded->erase(closed);
+      if (closed_keys->insert(StateKey(*state)).second) {
+        *closed_bytes += kClosedKeyBytes;
+      }
+    }
+    *node_bytes -= node->GetApproximateBytes();
+    node.reset();
+    num_freed++;
+  }
+  visited->erase(remove(visited->begin(), visited->end(), nullptr), visited->end());
+
+  // the weighted costs are final now
+  int num_kept = 0;
+  for (const SearchNode *node : queued) {
+    if (requeue.count(node) > 0) {
+      agenda->push(node);
+      num_kept++;
+    }
+  }
+  for (const SearchNode *node : reopened) {
+    agenda->push(node);
+  }
+
+  if (!options.quiet) {cout << "memory bound reached: kept " << num_kept << " of " << queued.size() << " queued nodes, queued " << reopened.size() << " expanded nodes again for their forgotten children and freed " << num_freed << " nodes" << endl;}
+}
+
+// (name, info) of a grounded action
+typedef pair<int, vector<int>> ActionKey;
+
+// Sleep set of a state: applicable actions that commute with some action taken
+// on the way to it and that were already applied before that action, so their
+// children are reached in the other order. Sleep sets are kept per state, and a
+// state reached again keeps the intersection of the sleep sets of its paths.
+typedef set<ActionKey> SleepSet;
+typedef unordered_map<const State*, SleepSet, StatePtrHash, StatePtrEqual> SleepSets;
+
+ActionKey GetActionKey(const Action &action) {
+  return ActionKey(action.GetName(), action.GetInfo());
+}
+
+// intersects the sleep set kept for state with sleep, true if that woke up
+// some action of state
+bool MergeSleepSet(const State *state, const SleepSet &sleep, SleepSets *sleep_sets) {
+  SleepSets::iterator iter = sleep_sets->find(state);
+  if (iter == sleep_sets->end()) {
+    (*sleep_sets)[state] = sleep;
+    return false;
+  }
+  bool woken = false;
+  for (SleepSet::iterator key = iter->second.begin(); key != iter->second.end();) {
+    if (sleep.count(*key) == 0) {
+      key = iter->second.erase(key);
+      woken = true;
+    } else {
+      ++key;
+    }
+  }
+  return woken;
+}
+
+// Children of an expanded node that passed the duplicate checks of
+// GenerateChildren, waiting for their heuristic costs to be queued.
+struct Expansion {
+  const SearchNode *node;
+  int num_actions;
+  vector<unique_ptr<Action>> actions;
+  vector<unique_ptr<State>> new_states;
+  vector<float> path_costs;
+  vector<float> heuristic_costs;
+  vector<int> heuristic_from;
+  vector<bool> queue;
+  vector<const State*> eval_states;
+  vector<int> eval_indices;
+  // with sleep sets, the sleep set of every child, and the states already
+  // reached by dropped children with the sleep sets of those children
+  vector<SleepSet> sleep;
+  vector<pair<const State*, SleepSet>> merges;
+  int count_duplicates;
+  int count_out_of_order;
+  int count_dominated;
+};
+
+// Drops children of node that leave the state unchanged, are already expanded
+// (unless reopening) or whose state already has a node or an earlier sibling
+// that is at least as cheap. Children dominated by a state in dominance (if
+// any) are dropped too. With sleep_sets, the actions in the sleep set of node
+// are not applied, and every child gets its sleep set. Cheaper duplicates take
+// the heuristic cost of the earlier node or sibling, so only new states are
+// left in eval_states. Only reads the search's tables, so several nodes can be
+// expanded at once.
+void GenerateChildren(const SearchNode *node, const vector<const Operator*> &operators, const Environment &env, bool add_only, const SearchOptions &options, const StateSet &expanded, const ClosedKeys &closed_keys, const BestNodes &best_nodes, const DominanceTable *dominance, const SleepSets *sleep_sets, Expansion *expansion) {
+  expansion->node = node;
+  expansion->count_duplicates = 0;
+  expansion->count_out_of_order = 0;
+  expansion->count_dominated = 0;
+  vector<unique_ptr<Action>> &actions = expansion->actions;
+  node->Actions(operators, env, &actions);
+  expansion->num_actions = actions.size();
+
+  const State *state = node->GetState();
+  expansion->new_states.resize(actions.size());
+  expansion->path_costs.resize(actions.size());
+  expansion->heuristic_costs.resize(actions.size());
+  expansion->heuristic_from.assign(actions.size(), -1);
+  expansion->queue.assign(actions.size(), false);
+  expansion->sleep.assign(sleep_sets != nullptr ? actions.size() : 0, SleepSet());
+  expansion->merges.clear();
+  // with sleep sets, the actions asleep in state and the actions applied so
+  // far whose children are searched
+  vector<int> asleep;
+  vector<int> applied;
+  if (sleep_sets != nullptr) {
+    SleepSets::const_iterator iter = sleep_sets->find(state);
+    for (int i = 0; iter != sleep_sets->end() && i < actions.size(); ++i) {
+      if (iter->second.count(GetActionKey(*actions[i])) > 0) {
+        asleep.push_back(i);
+      }
+    }
+  }
+  // cheapest sibling for every new state
+  unordered_map<const State*, int, StatePtrHash, StatePtrEqual> siblings;
+  for (int i = 0; i < actions.size(); ++i) {
+    if (sleep_sets != nullptr) {
+      if (find(asleep.begin(), asleep.end(), i) != asleep.end()) {
+        expansion->count_out_of_order++;
+        continue;
+      }
+      // the actions asleep or applied before that commute with this one stay
+      // asleep in its child
+      for (const vector<int> *indices : {&asleep, &applied}) {
+        for (const int j : *indices) {
+          if (!actions[j]->Interferes(*actions[i])) {
+            expansion->sleep[i].insert(GetActionKey(*actions[j]));
+          }
+        }
+      }
+    }
+    unique_ptr<State> new_state = node->CreateSuccessor(*actions[i], add_only);
+    if (options.symmetry != nullptr) {
+      new_state = options.symmetry->Canonical(*new_state, nullptr);
+    }
+    if (new_state->Hash() == state->Hash() && new_state->ApproximatelyEquals(state) && state->ApproximatelyEquals(new_state.get())) {
+      expansion->count_duplicates++;
+      continue;
+    }
+    // every other child is searched from its state, or from the state's
+    // earlier node with the sleep sets merged
+    applied.push_back(i);
+    StateSet::const_iterator closed = expanded.find(new_state.get());
+    if (!options.reopen && closed != expanded.end()) {
+      expansion->count_duplicates++;
+      if (sleep_sets != nullptr) {
+        expansion->merges.emplace_back(*closed, expansion->sleep[i]);
+      }
+      continue;
+    }
+    if (!options.reopen && !closed_keys.empty() && closed_keys.count(StateKey(*new_state)) > 0) {
+      expansion->count_duplicates++;
+      continue;
+    }
+    expansion->path_costs[i] = node->GetParentActionCost() + actions[i]->GetCost();
+    if (dominance != nullptr && dominance->Dominated(*new_state, expansion->path_costs[i])) {
+      expansion->count_dominated++;
+      continue;
+    }
+
+    unordered_map<const State*, int, StatePtrHash, StatePtrEqual>::iterator sibling = siblings.find(new_state.get());
+    if (sibling != siblings.end()) {
+      const int j = sibling->second;
+      expansion->count_duplicates++;
+      if (sleep_sets != nullptr) {
+        // the sibling left keeps what both children have asleep
+        SleepSet sleep;
+        for (const ActionKey &key : expansion->sleep[i]) {
+          if (expansion->sleep[j].count(key) > 0) {
+            sleep.insert(key);
+          }
+        }
+        expansion->sleep[i] = sleep;
+        expansion->sleep[j] = sleep;
+      }
+      if (expansion->path_costs[i] >= expansion->path_costs[j]) {
+        continue;
+      }
+      // replaces sibling j, whose state stays alive for its evaluation
+      expansion->queue[j] = false;
+      expansion->heuristic_from[i] = (expansion->heuristic_from[j] >= 0) ? expansion->heuristic_from[j] : j;
+      sibling->second = i;
+    } else {
+      BestNodes::const_iterator iter = best_nodes.find(new_state.get());
+      if (iter == best_nodes.end()) {
+        expansion->eval_states.push_back(new_state.get());
+        expansion->eval_indices.push_back(i);
+      } else if (expansion->path_costs[i] < iter->second->GetParentActionCost()) {
+        expansion->heuristic_costs[i] = iter->second->GetHeuristicCost();
+      } else {
+        expansion->count_duplicates++;
+        if (sleep_sets != nullptr) {
+          expansion->merges.emplace_back(iter->second->GetState(), expansion->sleep[i]);
+        }
+        continue;
+      }
+      siblings[new_state.get()] = i;
+    }
+    expansion->queue[i] = true;
+    expansion->new_states[i] = move(new_state);
+  }
+}
+
+// fills in the heuristic costs of the children from eval_costs, one for every
+// state in eval_states
+void SetHeuristicCosts(const vector<float> &eval_costs, Expansion *expansion) {
+  for (int i = 0; i < expansion->eval_indices.size(); ++i) {
+    expansion->heuristic_costs[expansion->eval_indices[i]] = eval_costs[i];
+  }
+  for (int i = 0; i < expansion->heuristic_from.size(); ++i) {
+    if (expansion->heuristic_from[i] >= 0) {
+      expansion->heuristic_costs[i] = expansion->heuristic_costs[expansion->heuristic_from[i]];
+    }
+  }
+}
+
+// Rewrites path, found from the canonical form of start_state, into the path
+// from start_state taking the symmetric actions. Returns false if some step
+// has no symmetric action.
+bool RelabelPath(const Symmetry &symmetry, const State &start_state, const vector<const Operator*> &operators, const Environment &env, vector<SearchNode::PathPair> *path) {
+  if (path->empty()) {
+    return true;
+  }
+  // maps the objects of state to those of the path's states
+  Symmetry::Permutation permutation;
+  symmetry.Canonical(start_state, &permutation);
+  unique_ptr<State> state(new State(start_state));
+  vector<SearchNode::PathPair> relabeled;
+  relabeled.emplace_back(*state, path->back().action);
+
+  for (int i = path->size() - 2; i >= 0; --i) {
+    const Action &action = (*path)[i].action;
+    State next = (*path)[i + 1].state;
+    action.Successor(&next);
+
+    vector<unique_ptr<Action>> actions;
+    for (const Operator *o : operators) {
+      o->ApplicableActions(*state, env, &actions);
+    }
+    unique_ptr<State> new_state;
+    const Action *new_action = nullptr;
+    for (const unique_ptr<Action> &a : actions) {
+      if (a->GetName() != action.GetName()) {
+        continue;
+      }
+      unique_ptr<State> candidate(new State(*state));
+      a->Successor(candidate.get());
+      unique_ptr<State> permuted = symmetry.Permute(*candidate, permutation);
+      if (permuted->ApproximatelyEquals(&next) && next.ApproximatelyEquals(permuted.get())) {
+        new_state = move(candidate);
+        new_action = a.get();
+        break;
+      }
+    }
+    if (new_action == nullptr) {
+      return false;
+    }
+    // the search stored the canonical form of next
+    const State &stored = (*path)[i].state;
+    if (!stored.ApproximatelyEquals(&next) || !next.ApproximatelyEquals(&stored)) {
+      Symmetry::Permutation canonical;
+      symmetry.Canonical(next, &canonical);
+      permutation = Symmetry::Compose(permutation, canonical);
+    }
+    relabeled.emplace_back(*new_state, *new_action);
+    state = move(new_state);
+  }
+
+  vector<SearchNode::PathPair> reversed;
+  for (int i = relabeled.size() - 1; i >= 0; --i) {
+    reversed.push_back(relabeled[i]);
+  }
+  *path = move(reversed);
+  return true;
+}
+
+} // namespace
+
+SearchNode::SearchNode(std::unique_ptr<const State> state, const SearchNode *parent, std::unique_ptr<const Action> action, float heuristic_cost, int count, float weight) : state_(move(state)), parent_(parent), action_(move(action)), heuristic_cost_(heuristic_cost), hmax_(-1.f), count_(count), weight_(weight), backed_up_cost_(-numeric_limits<float>::infinity()) {
     action_cost_ = (action_ == nullptr) ? 0.f : action_->GetCost();
     parent_cost_ = (parent_ == nullptr) ?  0.f : parent->GetParentActionCost();
 }
@@ -45,6 +465,10 @@ float SearchNode::GetWeight() const {
   return weight_;
 }
 
+void SearchNode::SetWeight(float weight) {
+  weight_ = weight;
+}
+
 float SearchNode::GetCost() const {
   return parent_cost_ + action_cost_ + heuristic_cost_;
 }
@@ -58,11 +482,15 @@ float SearchNode::GetHeuristicCost() const {
 }
 
 float SearchNode::GetWeightedCost() const {
-    return (parent_cost_ + action_cost_) * weight_ + heuristic_cost_ * (1.f - weight_);
+    return max((parent_cost_ + action_cost_) * weight_ + heuristic_cost_ * (1.f - weight_), backed_up_cost_);
+}
+
+void SearchNode::SetBackedUpCost(float cost) {
+  backed_up_cost_ = cost;
 }
 
 
-float SearchNode::GetHMax(vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) {
+float SearchNode::GetHMax(const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) const {
   if (hmax_ == -1.f) {
     hmax_ = HeuristicCost(HMax(), *(this->GetState()), goal_set, operators, env);
   }
@@ -109,10 +537,26 @@ const State* SearchNode::GetState() const {
   return state_.get();
 }
 
+const SearchNode* SearchNode::GetParent() const {
+  return parent_;
+}
+
+const Action& SearchNode::GetAction() const {
+  return *action_;
+}
+
 int SearchNode::GetCount() const {
   return count_;
 }
 
+size_t SearchNode::GetApproximateBytes() const {
+  size_t bytes = sizeof(SearchNode) + ApproximateStateBytes(*state_);
+  if (action_ != nullptr) {
+    bytes += sizeof(Action) + (action_->GetPreconditions().size() + action_->GetAddList().size() + action_->GetDeleteList().size()) * kFluentBytes;
+  }
+  return bytes;
+}
+
 void SearchNode::Actions(const vector<const Operator*> &operators, const Environment& env, vector<unique_ptr<Action>> *actions) const {
   for (const Operator* o : operators) {
     o->ApplicableActions(*state_, env, actions); 
@@ -130,31 +574,138 @@ unique_ptr<State> SearchNode::CreateSuccessor(const Action &action, bool add_onl
 }
 
 float HeuristicCost(const Heuristic &h, const State &initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment& env) {
-  float cost = h.Cost(initial_state, *goal_set[0], operators, env);
-  for (int i = 1; i < goal_set.size(); i++) {
-    float cmp_cost = h.Cost(initial_state, *goal_set[i], operators, env);
-    if (cmp_cost < cost) {
-      cost = cmp_cost;
+  return h.MinCost(initial_state, goal_set, operators, env);
+}
+
+const State* SatisfiedGoal(const vector<const State*> &goal_set, const State &state) {
+  for (const State *goal_state : goal_set) {
+    if (goal_state->SatisfiedBy(&state)) {
+      return goal_state;
     }
   }
-  return cost;
+  return nullptr;
 }
 
-bool Search(unique_ptr<const State> start_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, const Heuristic &h, bool verbose) {
-  return Search(move(start_state), goal_set, operators, env, h, verbose, 0.f, 0.f);
+void ReturnInterruptedPlan(const SearchNode &node, int count_expanded, const string &node_name, float value, const SearchOptions &options, vector<SearchNode::PathPair> *path, vector<float> *costs) {
+  if (!options.quiet) {cout << "search interrupted after " << count_expanded << " nodes expanded, returning the plan to " << node_name << " " << value << endl;}
+  node.GetPath(path);
+  node.GetCosts(costs);
 }
 
-bool Search(unique_ptr<const State> start_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, const Heuristic &h, bool verbose, float epsilon, float weight) {
+int UnseenChildren(const SearchNode &node, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic *h, const Environment &env, StateSet *seen, vector<unique_ptr<State>> *new_states, vector<unique_ptr<Action>> *actions, vector<float> *heuristic_costs) {
+  vector<unique_ptr<Action>> all_actions;
+  node.Actions(operators, env, &all_actions);
+  vector<const State*> eval_states;
+  int count_seen = 0;
+  for (unique_ptr<Action> &action : all_actions) {
+    unique_ptr<State> new_state = node.CreateSuccessor(*action, false);
+    if (!seen->insert(new_state.get()).second) {
+      count_seen++;
+      continue;
+    }
+    eval_states.push_back(new_state.get());
+    new_states->push_back(move(new_state));
+    actions->push_back(move(action));
+  }
+  for (const State *state : eval_states) {
+    heuristic_costs->push_back(h != nullptr ? h->MinCost(*state, goal_set, operators, env) : 0.f);
+  }
+  return count_seen;
+}
+
+bool Search(unique_ptr<const State> start_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, const Heuristic &h, const SearchOptions &options) {
+  if (!options.pdb_build_file.empty()) {
+    return BuildPatternDatabase(*start_state, *goal_set[0], ParsePatterns(options.pdb_patterns, *goal_set[0]), operators, env, options.pdb_buckets, options.pdb_max_states, options.pdb_build_file);
+  }
+
+  HPDB pdb(h);
+  if (!options.pdb_file.empty() && !pdb.Load(options.pdb_file, goal_set, operators, env)) {
+    return false;
+  }
+  const Heuristic &search_h = options.pdb_file.empty() ? h : pdb;
+
+  unique_ptr<Relevance> relevance;
+  vector<unique_ptr<RelevantOperator>> relevant_operators;
+  vector<const Operator*> search_operators = operators;
+  if (options.relevance) {
+    relevance.reset(new Relevance(*start_state, goal_set, operators, env, options.relevance_max_states));
+    cout << relevance->GetString() << endl;
+    if (relevance->PrunesAny()) {
+      search_operators.clear();
+      for (const Operator *o : operators) {
+        relevant_operators.emplace_back(new RelevantOperator(*o, *relevance));
+        search_operators.push_back(relevant_operators.back().get());
+      }
+      start_state = relevance->Prune(*start_state);
+    }
+  }
+
   vector<SearchNode::PathPair> path;
   vector<float> costs;
 
   State start_state_copy = *start_state;
+
+  SearchOptions search_options = options;
+  unique_ptr<Symmetry> symmetry;
+  // only UCSearch (also run by the portfolio) turns children into canonical states
+  bool uc_search = !options.portfolio.empty() || (options.lrta_lookahead <= 0 && !options.anytime && options.width_search.empty() && options.beam_width <= 0 && !options.ida && !options.hill_climbing && !options.greedy && options.threads <= 1);
+  if (options.symmetry_reduction && !uc_search) {
+    cout << "symmetry reduction is only done by the default search, ignoring it" << endl;
+  } else if (options.symmetry_reduction) {
+    symmetry.reset(new Symmetry(*start_state, goal_set, env));
+    cout << symmetry->GetString() << endl;
+    if (symmetry->Any()) {
+      search_options.symmetry = symmetry.get();
+      start_state = symmetry->Canonical(*start_state, nullptr);
+    }
+  }
     
   const chrono::steady_clock::time_point time_start = chrono::steady_clock::now();
-  bool search_result = UCSearch(move(start_state), goal_set, operators, h, env, &path, &costs, nullptr, false, verbose, epsilon, weight);
+  bool search_result;
+  if (!options.portfolio.empty()) {
+    search_result = PortfolioSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.lrta_lookahead > 0) {
+    // a resident planner keeps the table in memory and only reads the file
+    // for its first problem or when the goal changes, main saves it at exit
+    LearnedTable run_table;
+    LearnedTable *table = (options.learned_table != nullptr) ? options.learned_table : &run_table;
+    if (!table->ForGoal(goal_set)) {
+      if (options.lrta_table.empty()) {
+        table->Reset(goal_set);
+      } else if (!table->Load(options.lrta_table, goal_set)) {
+        return false;
+      }
+    }
+    search_result = RealTimeSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, table, search_options);
+    if (options.learned_table == nullptr && !options.lrta_table.empty() && !table->Save(options.lrta_table)) {
+      return false;
+    }
+  } else if (options.anytime) {
+    search_result = AnytimeSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (!options.width_search.empty()) {
+    search_result = WidthSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.beam_width > 0) {
+    search_result = BeamSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.ida) {
+    search_result = IDASearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.hill_climbing) {
+    search_result = HillClimbingSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.greedy) {
+    search_result = GreedySearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else if (options.threads > 1) {
+    search_result = HDASearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, search_options);
+  } else {
+    search_result = UCSearch(move(start_state), goal_set, search_operators, search_h, env, &path, &costs, nullptr, false, search_options);
+  }
   const chrono::steady_clock::time_point time_end = chrono::steady_clock::now();
   int ms = chrono::duration_cast<chrono::milliseconds>(time_end - time_start).count();
 
+  if (search_options.symmetry != nullptr && !RelabelPath(*symmetry, start_state_copy, search_operators, env, &path)) {
+    cerr << "no symmetric plan from the start state" << endl;
+    path.clear();
+    costs.clear();
+  }
+
   for (int i = path.size() - 1; i >= 0; --i) {
     cout << path[i].action.GetString() << endl << endl;
     path[i].action.Successor(&start_state_copy);
@@ -166,12 +717,20 @@ bool Search(unique_ptr<const State> start_state, const vector<const State*> &goa
     path[i].action.Successor(&start_state_copy);
   }
 
+  // an interrupted or step-limited search prints a plan that stops short of
+  // the goal, callers must not take it for a full plan
+  if (!path.empty()) {
+    if (SatisfiedGoal(goal_set, path[0].state) == nullptr) {
+      cout << "partial plan: the goal is not reached" << endl;
+    }
+  }
+
   cout << "search finished " << ((search_result) ? "successfully" : "unsuccessfully") << " after " << ms / 1000.f << " seconds" << endl;
 
   return search_result;
 }
 
-bool UCSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, float *cost, bool add_only, bool verbose, float epsilon, float weight) {
+bool UCSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, float *cost, bool add_only, const SearchOptions &options) {
   const int kNoAction = StringRegistry::Get()->GetInt("no_action");
 
   // search nodes that have been created and put in the agenda
@@ -180,64 +739,110 @@ bool UCSearch(unique_ptr<const State> initial_state, const vector<const State*>
 
   // search nodes waiting to be expanded
   // (consists of SearchNode pointers into visited list)
-  priority_queue<const SearchNode*, vector<const SearchNode*>, CompareSearchNodePtr> agenda;
+  unique_ptr<OpenList> agenda = CreateOpenList(options, goal_set, operators, env);
+  if (agenda == nullptr) {
+    cerr << "invalid open list " << options.open_list << endl;
+    return false;
+  }
+
+  // evaluates the new children of an expansion in parallel
+  unique_ptr<EvaluationPool> eval_pool;
+  if (options.eval_threads > 1) {
+    eval_pool.reset(new EvaluationPool(options.eval_threads));
+  }
 
   // states that have been expanded and their children put in the agenda
   // (consists of State pointers into visited list)
   StateSet expanded;
 
+  // cheapest node generated so far for every state
+  // (consists of State and SearchNode pointers into visited list)
+  BestNodes best_nodes;
+
+  // states queued so far, to drop the children they dominate
+  unique_ptr<DominanceTable> dominance;
+  if (options.dominance && !add_only) {
+    dominance.reset(new DominanceTable(goal_set));
+  }
+
+  // sleep set of every queued state, for options.partial_order (see SleepSet),
+  // which does not go with the pruning of symmetry, dominance or a memory bound
+  unique_ptr<SleepSets> sleep_sets;
+  if (options.partial_order && options.symmetry == nullptr && dominance == nullptr && options.max_nodes <= 0 && options.max_memory_mb <= 0) {
+    sleep_sets.reset(new SleepSets);
+  } else if (options.partial_order) {
+    cout << "partial order reduction does not go with symmetry, dominance or memory bounds, ignoring it" << endl;
+  }
+
+  // keys of the expanded states whose nodes were freed by PruneNodes, and the
+  // bytes they take
+  ClosedKeys closed_keys;
+  size_t closed_bytes = 0;
+  // approximate bytes held by the nodes in visited
+  size_t node_bytes = 0;
+
   // track the order and number of nodes that have been pushed onto the agenda 
   int count_visited = 0;
   int count_expanded = 0;
   int count_prev_expanded = 0;
+  int count_duplicates = 0;
+  int count_evals_skipped = 0;
+  int count_out_of_order = 0;
+  int count_woken = 0;
+  int count_dominated = 0;
+  int count_dead_ends = 0;
   //bool checked = false;
 
+  // expanded node with the lowest heuristic cost, its path is the partial plan
+  // returned if the search is interrupted
+  const SearchNode *best_partial = nullptr;
+
   float initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
-  visited.emplace_back(new SearchNode(move(initial_state), nullptr, std::unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, weight));
-  agenda.push(visited.back().get());
-
-  while (!agenda.empty()) {
-    const SearchNode *node = agenda.top();
-    agenda.pop();
-
-    if (epsilon > 0.f) {
-      float base_cost = node->GetParentActionCost();
-      float min_cost_to_goal = HeuristicCost(HMax(), *node->GetState(), goal_set, operators, env);
-
-      vector<const SearchNode*> considered_nodes;
-
-      // find node with lowest estimated cost to goal, with cost so far
-      // within epsilon from minimum cost so far
-      while (!agenda.empty() && agenda.top()->GetParentActionCost() <= (base_cost + epsilon)) {
-        //cout << "cost is: " << agenda.top()->GetCost() << ", base cost is: " << base_cost << endl;
-
-        float cost_to_goal = HeuristicCost(HMax(), *(agenda.top()->GetState()), goal_set, operators, env);
-        if (cost_to_goal < min_cost_to_goal) {
-          considered_nodes.push_back(node);
-          node = agenda.top();
-        } else {
-          considered_nodes.push_back(agenda.top());
-        }
-        agenda.pop();
-      }
-      // replace nodes in agenda
-      for (const SearchNode *node : considered_nodes) {
-        agenda.push(node);
+  visited.emplace_back(new SearchNode(move(initial_state), nullptr, std::unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, options.weight));
+  best_nodes[visited.back()->GetState()] = visited.back().get();
+  if (dominance != nullptr) {
+    dominance->Add(*visited.back()->GetState(), 0.f);
+  }
+  if (sleep_sets != nullptr) {
+    (*sleep_sets)[visited.back()->GetState()] = SleepSet();
+  }
+  node_bytes += visited.back()->GetApproximateBytes();
+  agenda->push(visited.back().get());
+
+  while (!agenda->empty()) {
+    if (options.Interrupted()) {
+      if (best_partial != nullptr && path != nullptr) {
+        ReturnInterruptedPlan(*best_partial, count_expanded, "the expanded node with the lowest heuristic cost", best_partial->GetHeuristicCost(), options, path, costs);
       }
+      return false;
     }
 
-    if (verbose) {cout << "\n" << endl;}
-
-    // check if state was previously expanded, otherwise mark as expanded
-    StateSet::const_iterator iter = expanded.find(node->GetState());
-    if (iter != expanded.end()) {
-        count_prev_expanded++;
-        if (verbose) {cout << "previously expanded: " << *node << endl;}
-    // expand state
-    } else {
-      if (verbose) {cout << "expanding node " << *node << endl;}
+    // pop the options.batch_size best nodes that are still to be expanded
+    // (just the best one by default) and mark them as expanded
+    vector<const SearchNode*> batch;
+    while (!agenda->empty() && batch.size() < max(1, options.batch_size)) {
+      const SearchNode *node = agenda->pop();
+
+      if (options.verbose) {cout << "\n" << endl;}
+
+      // check if a cheaper node for the state was queued after this one or the
+      // state was previously expanded, otherwise mark as expanded
+      if (best_nodes[node->GetState()] != node) {
+          count_prev_expanded++;
+          if (options.verbose) {cout << "superseded: " << *node << endl;}
+          continue;
+      } else if (Closed(*node->GetState(), expanded, closed_keys)) {
+          count_prev_expanded++;
+          if (options.verbose) {cout << "previously expanded: " << *node << endl;}
+          continue;
+      }
+      // expand state
+      if (options.verbose) {cout << "expanding node " << *node << endl;}
       expanded.insert(node->GetState());
       count_expanded++;
+      if (best_partial == nullptr || node->GetHeuristicCost() < best_partial->GetHeuristicCost()) {
+        best_partial = node;
+      }
 
       // check if state satisfies goal
 
@@ -248,35 +853,149 @@ bool UCSearch(unique_ptr<const State> initial_state, const vector<const State*>
           if (add_only) {
             *cost = node->GetCost();
           } else {
-            cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, solution cost: " << node->GetCost() << endl;
-            cout << "satisfies goal state " << *goal_state << endl;
+            // the portfolio reports the search that wins
+            if (!options.quiet) {
+              cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped, " << count_evals_skipped << " heuristic evaluations skipped, solution cost: " << node->GetCost() << endl;
+              if (sleep_sets != nullptr) {cout << count_out_of_order << " children of commuting actions pruned, " << count_woken << " nodes expanded again for woken actions" << endl;}
+              if (dominance != nullptr) {cout << count_dominated << " dominated children dropped" << endl;}
+              if (count_dead_ends > 0) {cout << count_dead_ends << " dead ends dropped" << endl;}
+              cout << "satisfies goal state " << *goal_state << endl;
+            }
             node->GetPath(path);
             node->GetCosts(costs);
           }
           return true;
         }
       }
+      batch.push_back(node);
+    }
+    if (batch.empty()) {
+      continue;
+    }
 
-      // get applicable actions
-      vector<unique_ptr<Action>> actions;
-      node->Actions(operators, env, &actions);
-
-      // add any children to agenda
-      if (actions.empty()) {
-        if (verbose) {cout << "no applicable actions" << endl;}
+    // generate and evaluate the children of the batch, in parallel if there
+    // is a pool and more than one node
+    vector<Expansion> expansions(batch.size());
+    if (batch.size() == 1) {
+      Expansion &expansion = expansions[0];
+      GenerateChildren(batch[0], operators, env, add_only, options, expanded, closed_keys, best_nodes, dominance.get(), sleep_sets.get(), &expansion);
+      // evaluate all new states of this expansion together
+      vector<float> eval_costs;
+      if (eval_pool != nullptr) {
+        eval_pool->MinCosts(h, expansion.eval_states, goal_set, operators, env, &eval_costs);
+      } else {
+        for (const State *state : expansion.eval_states) {
+          eval_costs.push_back(h.MinCost(*state, goal_set, operators, env));
+        }
+      }
+      SetHeuristicCosts(eval_costs, &expansion);
+    } else {
+      function<void(int)> expand = [&](int i) {
+        GenerateChildren(batch[i], operators, env, add_only, options, expanded, closed_keys, best_nodes, dominance.get(), sleep_sets.get(), &expansions[i]);
+        vector<float> eval_costs;
+        for (const State *state : expansions[i].eval_states) {
+          eval_costs.push_back(h.MinCost(*state, goal_set, operators, env));
+        }
+        SetHeuristicCosts(eval_costs, &expansions[i]);
+      };
+      if (eval_pool != nullptr) {
+        eval_pool->ForEach(batch.size(), expand);
       } else {
-        if (verbose) {cout << "predicted cost: " << node->GetCost() << ", " << actions.size() << " applicable actions" << endl << endl;}
-        for (unique_ptr<Action> &a : actions) {
-          unique_ptr<State> new_state = node->CreateSuccessor(*a, add_only);
+        for (int i = 0; i < batch.size(); ++i) {
+          expand(i);
+        }
+      }
+    }
+
+    // a state reached again with fewer actions asleep is expanded again for
+    // the woken actions
+    function<void(const State*, const SleepSet&)> merge_sleep_set = [&](const State *state, const SleepSet &sleep) {
+      if (MergeSleepSet(state, sleep, sleep_sets.get()) && expanded.erase(state) > 0) {
+        agenda->push(best_nodes[state]);
+        count_woken++;
+      }
+    };
+
+    // add any children to agenda, in the order the nodes were popped
+    for (Expansion &expansion : expansions) {
+      for (const pair<const State*, SleepSet> &merge : expansion.merges) {
+        merge_sleep_set(merge.first, merge.second);
+      }
+      const SearchNode *node = expansion.node;
+      count_duplicates += expansion.count_duplicates;
+      count_out_of_order += expansion.count_out_of_order;
+      count_dominated += expansion.count_dominated;
+      count_evals_skipped += expansion.num_actions - expansion.count_out_of_order - expansion.count_dominated - expansion.eval_states.size();
+      if (expansion.num_actions == 0) {
+        if (options.verbose) {cout << "no applicable actions" << endl;}
+        continue;
+      }
+      if (options.verbose) {cout << "predicted cost: " << node->GetCost() << ", " << expansion.num_actions << " applicable actions" << endl << endl;}
+
+      for (int i = 0; i < expansion.num_actions; ++i) {
+        if (!expansion.queue[i]) {
+          continue;
+        }
+        if (expansion.heuristic_costs[i] == numeric_limits<float>::infinity()) {
+          // no goal can be reached from it (e.g. an abstract dead end of the
+          // pattern database)
+          count_dead_ends++;
+          continue;
+        }
+        BestNodes::iterator best = best_nodes.find(expansion.new_states[i].get());
+        if (best != best_nodes.end() && expansion.path_costs[i] >= best->second->GetParentActionCost()) {
+          // queued by an earlier node of the batch
+          count_duplicates++;
+          if (sleep_sets != nullptr) {
+            merge_sleep_set(best->second->GetState(), expansion.sleep[i]);
+          }
+          continue;
+        }
+        if (dominance != nullptr) {
+          // an earlier child of the batch may dominate it
+          if (dominance->Dominated(*expansion.new_states[i], expansion.path_costs[i])) {
+            count_dominated++;
+            continue;
+          }
+          dominance->Add(*expansion.new_states[i], expansion.path_costs[i]);
+        }
 
-          float heuristic_cost = HeuristicCost(h, *new_state, goal_set, operators, env);
-          visited.emplace_back(new SearchNode(move(new_state), node, move(a), heuristic_cost, ++count_visited, weight));
-          agenda.push(visited.back().get());
+        visited.emplace_back(new SearchNode(move(expansion.new_states[i]), node, move(expansion.actions[i]), expansion.heuristic_costs[i], ++count_visited, options.weight));
+        const SearchNode *child = visited.back().get();
+        node_bytes += child->GetApproximateBytes();
+        // when reopening, the state may have been expanded by a cheaper node
+        // or by a node that PruneNodes freed since
+        expanded.erase(child->GetState());
+        if (!closed_keys.empty() && closed_keys.erase(StateKey(*child->GetState())) > 0) {
+          closed_bytes -= kClosedKeyBytes;
+        }
+        if (best != best_nodes.end()) {
+          // key the entry by the new node's state, the old node may be freed
+          best_nodes.erase(best);
+        }
+        best_nodes[child->GetState()] = child;
+        agenda->push(child);
+        if (sleep_sets != nullptr) {
+          MergeSleepSet(child->GetState(), expansion.sleep[i], sleep_sets.get());
+        }
 
-          if (verbose) {cout << "queued child " << *(visited.back()) << endl << endl;}
+        if (options.verbose) {cout << "queued child " << *child << endl << endl;}
+      }
+    }
+    const SearchNode *node = batch.back();
+    if (!options.verbose && !options.quiet && (count_expanded / 100) != (count_expanded - batch.size()) / 100) {cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped, " << count_duplicates << " duplicates dropped, " << count_evals_skipped << " heuristic evaluations skipped\nexpanding node #" << node->GetCount() << " cost:" << node->GetCost() << " " << *(node->GetState()) << endl << endl;}
+    // nodes of the batch may be freed
+    if (OverBound(options, visited.size(), node_bytes + closed_bytes, 1.f)) {
+      // pruning cannot free the closed keys, so past 3/4 of the bound it
+      // would only run again after every expansion
+      if (OverBound(options, 0, closed_bytes, 0.75f)) {
+        cout << "memory bound too small: the " << closed_keys.size() << " freed expanded states take " << (closed_bytes >> 20) << " MB, more than 3/4 of --max_memory_mb" << endl;
+        if (best_partial != nullptr && path != nullptr) {
+          ReturnInterruptedPlan(*best_partial, count_expanded, "the expanded node with the lowest heuristic cost", best_partial->GetHeuristicCost(), options, path, costs);
         }
+        return false;
       }
-      if (!verbose && (count_expanded % 100) == 0) {cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_prev_expanded << " nodes skipped\nexpanding node #" << node->GetCount() << " cost:" << node->GetCost() << " " << *(node->GetState()) << endl << endl;}
+      PruneNodes(options, best_partial, &visited, agenda.get(), &expanded, &best_nodes, &closed_keys, &node_bytes, &closed_bytes);
     }
   }
 
@@ -17,10 +17,13 @@
 #ifndef UC_SEARCH_H
 #define UC_SEARCH_H
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "heuristic.h"
 #include "operator.h"
+#include "search_options.h"
 #include "support.h"
 
 class SearchNode {
@@ -40,16 +43,24 @@ class SearchNode {
 
   float GetWeight() const;
 
+  // only for nodes that are not queued, as it changes the weighted cost
+  void SetWeight(float weight);
+
   float GetCost() const;
 
   float GetParentActionCost() const;
 
   float GetHeuristicCost() const;
 
-  float GetHMax(std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env);
+  // HMax cost to goal, computed on first use and cached
+  float GetHMax(const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env) const;
 
   float GetWeightedCost() const;
 
+  // raises the weighted cost to at least cost, the lowest weighted cost of the
+  // children forgotten under a memory bound; only for nodes that are not queued
+  void SetBackedUpCost(float cost);
+
   void GetCosts(std::vector<float> *costs) const;
   
   bool InPath(const State &state) const;
@@ -58,8 +69,15 @@ class SearchNode {
 
   const State* GetState() const;
 
+  const SearchNode* GetParent() const;
+
+  const Action& GetAction() const;
+
   int GetCount() const;
 
+  // rough heap footprint of the node with its state and action
+  size_t GetApproximateBytes() const;
+
   void Actions(const std::vector<const Operator*> &operators, const Environment& env, std::vector<std::unique_ptr<Action>> *actions) const;
 
   std::unique_ptr<State> CreateSuccessor(const Action &action, bool add_only) const;
@@ -71,9 +89,10 @@ class SearchNode {
   float parent_cost_;
   float action_cost_;
   float heuristic_cost_;
-  float hmax_;
+  mutable float hmax_;
   int count_;
   float weight_;
+  float backed_up_cost_;
 };
 
 inline std::ostream& operator<<(std::ostream &os, const SearchNode &search_node) {
@@ -81,23 +100,30 @@ inline std::ostream& operator<<(std::ostream &os, const SearchNode &search_node)
   return os;
 }
 
-// min priority queue
-struct CompareSearchNodePtr {
-  bool operator()(const SearchNode *lhs, const SearchNode *rhs) {
-    return lhs->GetWeightedCost() > rhs->GetWeightedCost();
-  }
-};
-
 float HeuristicCost(const Heuristic &h, const State &initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment& env);
 
+// the goal state satisfied by state, nullptr if none
+const State* SatisfiedGoal(const std::vector<const State*> &goal_set, const State &state);
 
-//TODO: change state and action to be const unique ptrs
-bool Search(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env, const Heuristic &h, bool verbose);
+// Prints why the search stopped and fills in path and costs with the plan to
+// node, for a search interrupted after count_expanded expansions. node_name
+// says which node it is and value what it was picked by, e.g. "the expanded
+// node with the lowest heuristic cost" and its heuristic cost.
+void ReturnInterruptedPlan(const SearchNode &node, int count_expanded, const std::string &node_name, float value, const SearchOptions &options, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs);
+
+// Children of node whose states are not in seen, with the actions reaching
+// them and their heuristic costs from h, evaluated together (0 if h is
+// nullptr). Their states are added to seen, so they must outlive it. Returns
+// the number of children dropped as seen.
+int UnseenChildren(const SearchNode &node, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic *h, const Environment &env, StateSet *seen, std::vector<std::unique_ptr<State>> *new_states, std::vector<std::unique_ptr<Action>> *actions, std::vector<float> *heuristic_costs);
 
-bool Search(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env, const Heuristic &h, bool verbose, float epsilon, float weight);
+
+//TODO: change state and action to be const unique ptrs
+// h is replaced by the tables in options.pdb_file if one is given
+bool Search(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Environment &env, const Heuristic &h, const SearchOptions &options);
 
 //TODO: change state and action to be const unique ptrs
 // this function will take ownership of initial_state
-bool UCSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, float *cost, bool add_only, bool verbose, float epsilon, float weight);
+bool UCSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, float *cost, bool add_only, const SearchOptions &options);
 
 #endif  // UC_SEARCH_H
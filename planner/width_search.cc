@@ -0,0 +1,265 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "string_registry.h"
+#include "width_search.h"
+
+using namespace std;
+
+namespace {
+
+// (predicate, args, value, rounded probability) of a fluent
+typedef tuple<int, vector<int>, int, float> Atom;
+
+// atoms and pairs of atoms made true by the states seen so far, every atom
+// numbered in the order it was first seen
+struct NoveltyTable {
+  map<Atom, uint32_t> atoms;
+  unordered_set<uint64_t> pairs; // numbers of the two atoms, the lower first
+};
+
+// novelty of state up to width, records its atoms and pairs in table
+int Novelty(const State &state, int width, NoveltyTable *table) {
+  vector<uint32_t> atoms;
+  int novelty = width + 1;
+  for (const Fluent &fluent : state.GetFluents()) {
+    Atom atom(fluent.GetPredicate(), fluent.GetArgs(), fluent.GetValue(), fluent.RoundProb(fluent.GetProb()));
+    pair<map<Atom, uint32_t>::iterator, bool> inserted = table->atoms.insert(make_pair(atom, static_cast<uint32_t>(table->atoms.size())));
+    if (inserted.second) {
+      novelty = 1;
+    }
+    atoms.push_back(inserted.first->second);
+  }
+  if (width >= 2) {
+    for (int i = 0; i < atoms.size(); ++i) {
+      for (int j = i + 1; j < atoms.size(); ++j) {
+        uint64_t pair = (static_cast<uint64_t>(min(atoms[i], atoms[j])) << 32) | max(atoms[i], atoms[j]);
+        if (table->pairs.insert(pair).second) {
+          novelty = min(novelty, 2);
+        }
+      }
+    }
+  }
+  return novelty;
+}
+
+// fewest goal fluents not satisfied by state among the goal states
+int GoalCount(const vector<const State*> &goal_set, const State &state) {
+  int goal_count = -1;
+  for (const State *goal_state : goal_set) {
+    int count = goal_state->GetFluents().size() - goal_state->NumSatisfiedBy(&state);
+    if (goal_count < 0 || count < goal_count) {
+      goal_count = count;
+    }
+  }
+  return goal_count;
+}
+
+// prints the solution and fills in path and costs
+void ReturnPlan(const SearchNode &node, const State &goal_state, int count_expanded, int count_visited, int count_pruned, int width, vector<SearchNode::PathPair> *path, vector<float> *costs) {
+  cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_pruned << " nodes pruned, width " << width << ", solution cost: " << node.GetCost() << endl;
+  cout << "satisfies goal state " << goal_state << endl;
+  node.GetPath(path);
+  node.GetCosts(costs);
+}
+
+// children of node and the actions reaching them
+void Children(const SearchNode &node, const vector<const Operator*> &operators, const Environment &env, vector<unique_ptr<State>> *new_states, vector<unique_ptr<Action>> *actions) {
+  node.Actions(operators, env, actions);
+  for (const unique_ptr<Action> &action : *actions) {
+    new_states->push_back(node.CreateSuccessor(*action, false));
+  }
+}
+
+// IW(width), false if the search failed or was interrupted
+bool IteratedWidth(const State &initial_state, int width, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Environment &env, const SearchOptions &options, vector<SearchNode::PathPair> *path, vector<float> *costs, bool *interrupted) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  vector<unique_ptr<SearchNode>> visited;
+  StateSet seen;
+  NoveltyTable table;
+  deque<const SearchNode*> queue;
+  // node with the fewest goal fluents left, for an interrupted search
+  const SearchNode *best_partial = nullptr;
+  int best_goal_count = 0;
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_pruned = 0;
+
+  visited.emplace_back(new SearchNode(unique_ptr<const State>(new State(initial_state)), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), 0.f, ++count_visited, 0.f));
+  seen.insert(visited.back()->GetState());
+  Novelty(initial_state, width, &table);
+  queue.push_back(visited.back().get());
+  best_partial = visited.back().get();
+  best_goal_count = GoalCount(goal_set, initial_state);
+  const State *goal_state = SatisfiedGoal(goal_set, initial_state);
+  if (goal_state != nullptr) {
+    ReturnPlan(*best_partial, *goal_state, count_expanded, count_visited, count_pruned, width, path, costs);
+    return true;
+  }
+
+  while (!queue.empty()) {
+    if (options.Interrupted()) {
+      ReturnInterruptedPlan(*best_partial, count_expanded, "the node with the fewest goal fluents left", best_goal_count, options, path, costs);
+      *interrupted = true;
+      return false;
+    }
+    const SearchNode *node = queue.front();
+    queue.pop_front();
+    count_expanded++;
+
+    vector<unique_ptr<State>> new_states;
+    vector<unique_ptr<Action>> actions;
+    Children(*node, operators, env, &new_states, &actions);
+    for (int i = 0; i < new_states.size(); ++i) {
+      if (seen.count(new_states[i].get()) > 0) {
+        continue;
+      }
+      // goals are checked when generated, the first is the shallowest
+      goal_state = SatisfiedGoal(goal_set, *new_states[i]);
+      if (goal_state == nullptr && Novelty(*new_states[i], width, &table) > width) {
+        // copies generated later are not novel either
+        count_pruned++;
+        continue;
+      }
+      seen.insert(new_states[i].get());
+      visited.emplace_back(new SearchNode(move(new_states[i]), node, move(actions[i]), 0.f, ++count_visited, 0.f));
+      const SearchNode *child = visited.back().get();
+      if (goal_state != nullptr) {
+        ReturnPlan(*child, *goal_state, count_expanded, count_visited, count_pruned, width, path, costs);
+        return true;
+      }
+      int goal_count = GoalCount(goal_set, *child->GetState());
+      if (goal_count < best_goal_count) {
+        best_partial = child;
+        best_goal_count = goal_count;
+      }
+      queue.push_back(child);
+    }
+  }
+
+  cout << "IW(" << width << ") failed after " << count_expanded << " nodes expanded, " << count_pruned << " nodes pruned" << endl;
+  return false;
+}
+
+// (novelty, goal fluents left, heuristic cost, count, node), lowest first
+typedef tuple<int, int, float, int, const SearchNode*> Entry;
+
+bool BestFirstWidth(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, const SearchOptions &options, vector<SearchNode::PathPair> *path, vector<float> *costs) {
+  const int kNoAction = StringRegistry::Get()->GetInt("no_action");
+
+  vector<unique_ptr<SearchNode>> visited;
+  StateSet seen;
+  // novelty among the states with the same number of goal fluents left
+  unordered_map<int, NoveltyTable> tables;
+  priority_queue<Entry, vector<Entry>, greater<Entry>> agenda;
+  const SearchNode *best_partial = nullptr;
+  int best_goal_count = 0;
+
+  int count_visited = 0;
+  int count_expanded = 0;
+  int count_evaluated = 0;
+
+  float initial_heuristic_cost = 0.f;
+  if (options.width_heuristic) {
+    initial_heuristic_cost = HeuristicCost(h, *initial_state, goal_set, operators, env);
+    count_evaluated++;
+  }
+  int initial_goal_count = GoalCount(goal_set, *initial_state);
+  int initial_novelty = Novelty(*initial_state, options.width, &tables[initial_goal_count]);
+  visited.emplace_back(new SearchNode(move(initial_state), nullptr, unique_ptr<const Action>(new Action(kNoAction, 0.f, {}, {}, {})), initial_heuristic_cost, ++count_visited, 0.f));
+  seen.insert(visited.back()->GetState());
+  agenda.push(Entry(initial_novelty, initial_goal_count, initial_heuristic_cost, count_visited, visited.back().get()));
+  best_partial = visited.back().get();
+  best_goal_count = initial_goal_count;
+
+  while (!agenda.empty()) {
+    if (options.Interrupted()) {
+      ReturnInterruptedPlan(*best_partial, count_expanded, "the node with the fewest goal fluents left", best_goal_count, options, path, costs);
+      return false;
+    }
+    const SearchNode *node = get<4>(agenda.top());
+    agenda.pop();
+    count_expanded++;
+
+    const State *goal_state = SatisfiedGoal(goal_set, *node->GetState());
+    if (goal_state != nullptr) {
+      cout << "found goal state! " << count_expanded << " nodes expanded, " << count_visited << " nodes visited, " << count_evaluated << " heuristic evaluations, solution cost: " << node->GetCost() << endl;
+      cout << "satisfies goal state " << *goal_state << endl;
+      node->GetPath(path);
+      node->GetCosts(costs);
+      return true;
+    }
+
+    vector<unique_ptr<State>> new_states;
+    vector<unique_ptr<Action>> actions;
+    vector<float> heuristic_costs;
+    UnseenChildren(*node, goal_set, operators, options.width_heuristic ? &h : nullptr, env, &seen, &new_states, &actions, &heuristic_costs);
+    if (options.width_heuristic) {
+      count_evaluated += new_states.size();
+    }
+
+    for (int j = 0; j < new_states.size(); ++j) {
+      int goal_count = GoalCount(goal_set, *new_states[j]);
+      int novelty = Novelty(*new_states[j], options.width, &tables[goal_count]);
+      visited.emplace_back(new SearchNode(move(new_states[j]), node, move(actions[j]), heuristic_costs[j], ++count_visited, 0.f));
+      agenda.push(Entry(novelty, goal_count, heuristic_costs[j], count_visited, visited.back().get()));
+      if (goal_count < best_goal_count) {
+        best_partial = visited.back().get();
+        best_goal_count = goal_count;
+      }
+    }
+
+    if (!options.verbose && !options.quiet && (count_expanded % 100) == 0) {cout << count_expanded << " nodes expanded, " << count_visited << " nodes visited, fewest goal fluents left: " << best_goal_count << endl;}
+  }
+
+  // search failed
+  return false;
+}
+
+} // namespace
+
+bool WidthSearch(unique_ptr<const State> initial_state, const vector<const State*> &goal_set, const vector<const Operator*> &operators, const Heuristic &h, const Environment &env, vector<SearchNode::PathPair> *path, vector<float> *costs, const SearchOptions &options) {
+  if (options.width < 1 || options.width > 2) {
+    cerr << "width must be 1 or 2" << endl;
+    return false;
+  }
+  if (options.width_search == "iw") {
+    bool interrupted = false;
+    for (int width = 1; width <= options.width && !interrupted; ++width) {
+      if (IteratedWidth(*initial_state, width, goal_set, operators, env, options, path, costs, &interrupted)) {
+        return true;
+      }
+    }
+    return false;
+  } else if (options.width_search == "bfws") {
+    return BestFirstWidth(move(initial_state), goal_set, operators, h, env, options, path, costs);
+  }
+  cerr << "invalid width search " << options.width_search << endl;
+  return false;
+}
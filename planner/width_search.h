@@ -0,0 +1,46 @@
+/*
+ * Copyright 2015 Ciara Kamahele-Sanfratello
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WIDTH_SEARCH_H
+#define WIDTH_SEARCH_H
+
+#include <memory>
+#include <vector>
+
+#include "heuristic.h"
+#include "operator.h"
+#include "search_options.h"
+#include "support.h"
+#include "uc_search.h"
+
+// Width-based search. The atoms of a state are its fluents with their
+// probabilities rounded as in the state hash, and the novelty of a state is
+// the size of the smallest tuple of its atoms, up to options.width (1 or 2),
+// that no state seen before made true, or options.width + 1 if there is none.
+//
+// options.width_search selects the search:
+//  "iw"   IW(k): breadth-first search that prunes the states of novelty
+//         above k, for k from 1 up to options.width until a goal is found.
+//  "bfws" best-first width search: expands states of lowest novelty first,
+//         then those with the fewest goal fluents left. Novelty is measured
+//         separately among the states with the same number of goal fluents
+//         left. With options.width_heuristic, the heuristic cost breaks the
+//         remaining ties, otherwise no heuristic is evaluated.
+//
+// this function will take ownership of initial_state
+bool WidthSearch(std::unique_ptr<const State> initial_state, const std::vector<const State*> &goal_set, const std::vector<const Operator*> &operators, const Heuristic &h, const Environment &env, std::vector<SearchNode::PathPair> *path, std::vector<float> *costs, const SearchOptions &options);
+
+#endif  // WIDTH_SEARCH_H
@@ -18,9 +18,71 @@ from Primitives.KitchenPrimitives import KitchenState, KitchenAction
 import subprocess, threading, time, Queue
             
 class KitchenPlanner(Planner):
-    def __init__(self):
+    # with a positive lookahead, every step runs the real-time search for the
+    # next action only, with the costs it learned kept in table
+    def __init__(self, lookahead=0, table=None):
         self.path = '/Users/ciara/Dropbox/Ciara/LIS/planner'
         self.plan = None
+        self.lookahead = lookahead
+        self.table = table if table is not None else self.path + '/lrta.txt'
+        self.server = None
+
+    # with a positive lookahead one planner is kept running (--serve) with its
+    # learned costs in memory; every step writes the problem to its stdin and
+    # reads its output up to the end of request line
+    def start_server(self, timeout, weight):
+        self.server = subprocess.Popen(['%s/main' % self.path,
+                                        '--serve',
+                                        '--file=true',
+                                        '--problem=kitchen',
+                                        '--weight=' + str(weight),
+                                        '--epsilon=0.0',
+                                        '--time_limit=%.1f' % (0.9 * timeout),
+                                        '--lrta_lookahead=%d' % self.lookahead,
+                                        '--lrta_table=' + self.table],
+                                       stdin=subprocess.PIPE, stdout=subprocess.PIPE)
+        self.lines = Queue.Queue()
+        def reader(out, lines):
+            for line in iter(out.readline, ''):
+                lines.put(line)
+            lines.put(None)
+        thread = threading.Thread(target=reader, args=[self.server.stdout, self.lines])
+        thread.daemon = True
+        thread.start()
+
+    # closing stdin makes the planner save its learned costs and exit
+    def stop_server(self):
+        if self.server is not None:
+            self.server.stdin.close()
+            self.server.wait()
+            self.server = None
+
+    def __del__(self):
+        self.stop_server()
+
+    def run_server(self, timeout, weight):
+        if self.server is None:
+            self.start_server(timeout, weight)
+        self.server.stdin.write(open('%s/temp.txt' % self.path).read() + '\n')
+        self.server.stdin.flush()
+        out = []
+        deadline = time.time() + timeout
+        while True:
+            try:
+                line = self.lines.get(timeout=max(0.0, deadline - time.time()))
+            except Queue.Empty:
+                line = None
+            if line is None:
+                # timed out or exited; the next step starts a new planner
+                self.server.kill()
+                self.server = None
+                print "killed"
+                return False
+            if line == 'end of request\n':
+                break
+            out.append(line)
+        self.parse_plan(''.join(out))
+        return True
 
     def write_input_file(self, initial_state, goal_state):
         f = open(self.path + '/temp.txt', 'w')
@@ -50,18 +112,24 @@ class KitchenPlanner(Planner):
             f.write('%.2f\n' % x)
         f.close()
 
+    # the planner gets a time limit a little below timeout, so that it stops on
+    # its own and prints a partial plan before it would be killed
     def run_cmd(self, timeout, weight):
+        if self.lookahead > 0:
+            return self.run_server(timeout, weight)
         q = Queue.Queue()
         def target(q):
             input_file = open('%s/temp.txt' % self.path)
             #print 'waiting to replan'
             #raw_input()
             #print 'replanning with w=%.2f' % weight
-            self.process = subprocess.Popen(['%s/main' % self.path,
-                                  '--file=true',
-                                  '--problem=kitchen',
-                                  '--weight=' + str(weight),
-                                  '--epsilon=0.0'],
+            args = ['%s/main' % self.path,
+                    '--file=true',
+                    '--problem=kitchen',
+                    '--weight=' + str(weight),
+                    '--epsilon=0.0',
+                    '--time_limit=%.1f' % (0.9 * timeout)]
+            self.process = subprocess.Popen(args,
                                  stdin=input_file,
                                  stdout=subprocess.PIPE, stderr=subprocess.PIPE)
             out, err = self.process.communicate()
@@ -83,9 +151,12 @@ class KitchenPlanner(Planner):
             return True
 
 
+    # a partial plan stops short of the goal, so it does not end with 'arg' and
+    # the planner is called again once its actions are used up
     def parse_plan(self, out):
         try:
             plan = out.split('\n')
+            partial = 'partial plan: the goal is not reached' in plan
             self.plan = []
             for i in range(len(plan)):
                 if plan[i][0:4] == 'move':
@@ -104,19 +175,28 @@ class KitchenPlanner(Planner):
                     args = plan[i][10:].split('_')
                     self.plan.append(KitchenAction('alh', [int(arg) for arg in args]))
                 elif plan[i][0:8] == 'look_obj':
-                    args = plan[i][9:].split('_')
-                    self.plan.append(KitchenAction('alo', [int(arg) for arg in args]))
-            self.plan.append(KitchenAction('arg'))
+                    args = [int(arg) for arg in plan[i][9:].split('_')]
+                    # look_obj_<obj>_<loc>_<k> is the look repeated k times
+                    repeats = args[2] if len(args) > 2 else 1
+                    for _ in range(repeats):
+                        self.plan.append(KitchenAction('alo', args[0:2]))
+            # no plan at all, e.g. at a dead end or if the learned costs
+            # could not be loaded
+            if 'search finished successfully' not in out and (not partial or not self.plan):
+                self.plan = None
+            elif not partial:
+                self.plan.append(KitchenAction('arg'))
         except:
             print "parse_plan exception"
             print out
+            self.plan = None
         #for a in self.plan:
             #print a
 
     def next_action(self, initial_state, goal_state, prev_obs):
         replanned = False
         # replan
-        if self.plan is None or prev_obs is None or prev_obs == 'onone':
+        if not self.plan or prev_obs is None or prev_obs == 'onone' or self.lookahead > 0:
             replanned = True
             self.write_input_file(initial_state, goal_state)
 
@@ -130,12 +210,15 @@ class KitchenPlanner(Planner):
             success = self.run_cmd(600, 0.35)
             if not success:
                 print "could not make a plan in 10 minutes"
-                assert(False)
+                self.plan = None
 
             #while (success and weight < 0.35):
                 #success = self.run_cmd(10, weight + 0.05)
                 #weight += 0.05
 
             #print "done replanning"
+        if self.plan is None:
+            print "the planner failed"
+            return (None, 1 if replanned else 0)
         return (self.plan.pop(0), 1 if replanned else 0)
 
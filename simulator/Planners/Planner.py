@@ -13,6 +13,7 @@
 # limitations under the License.
 
 # Planner is a generic interface used by Simulators to choose the next action to take
+# next_action returns (action, replanned), with action None if planning failed
 class Planner:
     def __init__(self):
         pass
@@ -47,12 +47,18 @@ class Simulator:
             replan = 0
             step = 0
             obs = None
+            planner_failed = False
             for step in range(steps):
                 start_time = time.time()
                 action, replanned = self.planner.next_action(self.belief_state, goal_state, obs)
                 replan += replanned
                 planning_time += time.time() - start_time
 
+                # a failed planner run ends the simulation unsuccessfully
+                if action is None:
+                    planner_failed = True
+                    break
+
                 # stop if planner believes we have reached goal state
                 if action.action == 'arg':
                     break
@@ -83,7 +89,7 @@ class Simulator:
                 #else:
                     #print ''
 
-            if self.world.success(goal_state):
+            if not planner_failed and self.world.success(goal_state):
                 #print 'Successful :)'
                 successful_sims += 1
                 discount_reward += 100 * discount ** (step + 1)